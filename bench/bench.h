@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+// 极简基准测试框架：BENCHMARK 定义并注册一组测量，bench_main.cpp 依次运行。
+// 结果只输出到标准输出，同一台机器上前后两次运行可直接对比；不做统计显著性检验。
+namespace bench {
+
+struct Case {
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<Case>& cases()
+{
+    static std::vector<Case> all;
+    return all;
+}
+
+struct Registrar {
+    Registrar(const char* name, void (*run)()) { cases().push_back({ name, run }); }
+};
+
+// 防止被测结果被编译器优化掉
+template <typename T>
+inline void keep(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// 运行 fn(i)，i = 0..count-1，返回每次的平均纳秒
+template <typename Fn>
+double nsPerOp(std::size_t count, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i)
+        fn(i);
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return count == 0 ? 0 : elapsed / static_cast<double>(count);
+}
+
+inline void report(const char* what, double value, const char* unit)
+{
+    std::printf("  %-52s %12.2f %s\n", what, value, unit);
+}
+
+} // namespace bench
+
+#define BENCHMARK(name)                                               \
+    static void name();                                               \
+    static const bench::Registrar name##_registrar { #name, &name }; \
+    static void name()
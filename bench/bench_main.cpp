@@ -0,0 +1,20 @@
+#include "bench.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+
+// 用法：black-arrow-bench [用例名子串]。应使用 release 构建运行
+int main(int argc, char* argv[])
+{
+    const char* filter = argc > 1 ? argv[1] : "";
+    // 逐单的日志会淹没被测代码本身的耗时
+    spdlog::set_level(spdlog::level::warn);
+    for (const auto& c : bench::cases()) {
+        if (!std::strstr(c.name, filter))
+            continue;
+        std::printf("%s\n", c.name);
+        c.run();
+    }
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "bench.h"
+#include "fix_message_converter.h"
+#include "fix_order_parser.h"
+
+#include <quickfix/Message.h>
+
+#include <string>
+
+namespace {
+
+constexpr std::size_t kMessages = 1000000;
+
+// '|' 换成 SOH，补上 BeginString、BodyLength 与 CheckSum
+std::string frame(std::string body)
+{
+    for (auto& c : body) {
+        if (c == '|')
+            c = '\x01';
+    }
+    auto message = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    unsigned sum = 0;
+    for (unsigned char c : message)
+        sum += c;
+    auto checksum = std::to_string(sum % 256);
+    return message + "10=" + std::string(3 - checksum.size(), '0') + checksum + "\x01";
+}
+
+const std::string kNewOrder = frame("35=D|49=CLIENT|56=ACCEPTOR|34=12|52=20240101-00:00:00.000|11=0A8BWVRAW0001|"
+                                    "1=ACC-001|55=AAPL|54=1|38=100|40=2|44=150.25|59=0|60=20240101-00:00:00.000|");
+
+} // namespace
+
+// 一条 NewOrderSingle 的解码：QuickFIX 解析成 FIX::Message 再按字段读取，对比零拷贝扫描
+BENCHMARK(fixOrderParser)
+{
+    common::Order order;
+    auto quickfix = bench::nsPerOp(kMessages, [&](std::size_t) {
+        FIX::Message message(kNewOrder, false);
+        bench::keep(FixMessageConverter::parseNewOrderSingle(FIX44::NewOrderSingle(message), order));
+    });
+    bench::report("FIX::Message + FixMessageConverter", quickfix, "ns/msg");
+
+    InboundOrderView view;
+    auto parser = bench::nsPerOp(kMessages, [&](std::size_t) { bench::keep(FixOrderParser::parse(kNewOrder, view)); });
+    bench::report("FixOrderParser", parser, "ns/msg");
+
+    auto toOrder = bench::nsPerOp(kMessages, [&](std::size_t) {
+        std::string origClOrdId;
+        FixOrderParser::parse(kNewOrder, view);
+        FixMessageConverter::toOrder(view, order, origClOrdId);
+        bench::keep(order);
+    });
+    bench::report("FixOrderParser + toOrder", toOrder, "ns/msg");
+}
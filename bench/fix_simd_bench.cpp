@@ -0,0 +1,29 @@
+#include "bench.h"
+#include "fix_simd.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+// 按 SOH 查找的吞吐，每个 CPU 支持的实现各测一次
+BENCHMARK(fixSimdFindAll)
+{
+    // 字段平均约 12 字节，与常见订单报文相近
+    std::mt19937 rng(3);
+    std::string text(1 << 20, 'x');
+    for (std::size_t i = 0; i < text.size(); i += 4 + rng() % 16)
+        text[i] = '\x01';
+    std::vector<std::uint32_t> out(text.size());
+
+    auto saved = fixsimd::level();
+    for (auto level : { fixsimd::Level::Scalar, fixsimd::Level::Sse42, fixsimd::Level::Avx2 }) {
+        if (fixsimd::setLevel(level) != level)
+            continue;
+        constexpr std::size_t kRounds = 200;
+        auto ns = bench::nsPerOp(
+            kRounds, [&](std::size_t) { bench::keep(fixsimd::findAll(text, '\x01', out.data(), out.size())); });
+        auto label = std::string("findAll ") + fixsimd::levelName(level);
+        bench::report(label.c_str(), static_cast<double>(text.size()) / ns, "GB/s");
+    }
+    fixsimd::setLevel(saved);
+}
@@ -0,0 +1,72 @@
+#include "bench.h"
+#include "domain_service.h"
+#include "matching_engine.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kOrders = 1000000;
+
+// 围绕 100 上下 5 个价位的随机限价单，约一半与对手方成交，其余挂单
+std::vector<BookOrderRequest> randomFlow(std::size_t count)
+{
+    std::mt19937_64 rng(11);
+    std::vector<BookOrderRequest> flow(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& r = flow[i];
+        r.id = i + 1;
+        r.side = rng() % 2 == 0 ? '1' : '2';
+        r.price = static_cast<std::int64_t>(95 + rng() % 11) * common::kFixedScale;
+        r.quantity = static_cast<std::int64_t>(1 + rng() % 10) * common::kFixedScale;
+    }
+    return flow;
+}
+
+} // namespace
+
+// 单个订单簿的撮合吞吐，不含风控、存储与回报
+BENCHMARK(orderBookMatch)
+{
+    auto flow = randomFlow(kOrders);
+    OrderBook book;
+    std::vector<BookFill> fills;
+    std::size_t total = 0;
+    auto ns = bench::nsPerOp(flow.size(), [&](std::size_t i) {
+        fills.clear();
+        book.match(flow[i], true, fills);
+        total += fills.size();
+    });
+    bench::keep(total);
+    bench::report("match + rest", ns, "ns/order");
+    bench::report("throughput", 1e3 / ns, "M orders/s");
+    bench::report("fills per order", static_cast<double>(total) / flow.size(), "");
+}
+
+// 经 DomainService 的完整下单路径（风控、存储、撮合、事件发布）
+BENCHMARK(domainServiceMatch)
+{
+    DomainConfig config;
+    config.risk.defaults.max_msgs_per_sec = 0;
+    config.risk.defaults.price_band = 0;
+    DomainService svc(config);
+    auto flow = randomFlow(kOrders / 10);
+    std::vector<common::Order> orders(flow.size());
+    for (std::size_t i = 0; i < flow.size(); ++i) {
+        auto& o = orders[i];
+        o.clOrdId = "C" + std::to_string(i);
+        o.symbol = "AAPL";
+        o.account = "ACC";
+        o.side = flow[i].side;
+        o.orderType = '2';
+        o.price = common::fromFixed(flow[i].price);
+        o.quantity = common::fromFixed(flow[i].quantity);
+        o.session = "FIX.4.4:ACCEPTOR->CLIENT";
+    }
+    auto ns = bench::nsPerOp(
+        orders.size(), [&](std::size_t i) { bench::keep(svc.processNewOrder(orders[i]).success); });
+    bench::report("processNewOrder", ns, "ns/order");
+    bench::report("throughput", 1e3 / ns, "M orders/s");
+}
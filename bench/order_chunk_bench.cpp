@@ -0,0 +1,42 @@
+#include "bench.h"
+#include "order_store.h"
+
+#include <string>
+
+// 列式存储每个订单占用的字节数，以及只读状态列的过滤扫描速度。
+// 缓存未命中数用外部工具采集，例如 perf stat -e cache-misses black-arrow-bench orderChunk
+BENCHMARK(orderChunkLayout)
+{
+    bench::report("row layout (sizeof common::Order)", sizeof(common::Order), "bytes/order");
+    bench::report("columnar chunk (sizeof OrderChunk / kCapacity)",
+        static_cast<double>(sizeof(OrderChunk)) / OrderChunk::kCapacity, "bytes/order");
+
+    constexpr std::size_t kOrders = 1000000;
+    OrderStore store;
+    store.reserve(kOrders);
+    for (std::size_t i = 0; i < kOrders; ++i) {
+        common::Order o;
+        o.orderId = "O" + std::to_string(i);
+        o.clOrdId = "C" + std::to_string(i);
+        o.symbol = "AAPL";
+        o.account = "ACC";
+        o.side = '1';
+        o.orderType = '2';
+        o.price = 10;
+        o.quantity = 100;
+        o.session = "FIX.4.4:ACCEPTOR->CLIENT";
+        // 百分之一为部分成交，过滤扫描只还原这些订单
+        o.status = i % 100 == 0 ? "PARTIALLY_FILLED" : "NEW";
+        store.insert(o);
+    }
+    auto snap = store.publish();
+    std::size_t matched = 0;
+    auto ns = bench::nsPerOp(1, [&](std::size_t) {
+        snap->scan(0, OrderFilter { common::OrderState::PartiallyFilled, {} }, [&](const common::Order&) {
+            ++matched;
+            return true;
+        });
+    });
+    bench::keep(matched);
+    bench::report("filtered scan by state", ns / kOrders, "ns/order");
+}
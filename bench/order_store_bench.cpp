@@ -0,0 +1,77 @@
+#include "bench.h"
+#include "domain_service.h"
+#include "order_store.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kSizes[] = { 1000, 10000, 100000, 1000000 };
+
+common::Order restingOrder(std::size_t i)
+{
+    common::Order o;
+    o.clOrdId = "C" + std::to_string(i);
+    o.symbol = "AAPL";
+    o.account = "ACC";
+    o.side = '1';
+    o.orderType = '2';
+    o.price = 10;
+    o.quantity = 100;
+    o.session = "FIX.4.4:ACCEPTOR->CLIENT";
+    return o;
+}
+
+} // namespace
+
+// 撤单延迟与存储中订单数的关系：按 (会话, ClOrdID) 的索引查找应与订单数无关
+BENCHMARK(orderStoreCancelLatency)
+{
+    DomainConfig config;
+    config.risk.defaults.max_msgs_per_sec = 0;
+    config.risk.defaults.price_band = 0;
+    for (auto size : kSizes) {
+        DomainService svc(config);
+        for (std::size_t i = 0; i < size; ++i)
+            svc.processNewOrder(restingOrder(i));
+        // 撤掉均匀分布在整个存储中的 1000 个订单
+        constexpr std::size_t kCancels = 1000;
+        auto step = size / kCancels;
+        std::vector<common::Order> requests;
+        for (std::size_t i = 0; i < kCancels; ++i) {
+            auto o = restingOrder(i * step);
+            o.clOrdId += "-X";
+            requests.push_back(o);
+        }
+        auto ns = bench::nsPerOp(kCancels, [&](std::size_t i) {
+            auto r = svc.processCancelOrder(requests[i], "C" + std::to_string(i * step));
+            bench::keep(r.success);
+        });
+        auto label = "cancel, " + std::to_string(size) + " orders";
+        bench::report(label.c_str(), ns, "ns/op");
+    }
+}
+
+// 只测存储本身的查找
+BENCHMARK(orderStoreLookup)
+{
+    for (auto size : kSizes) {
+        OrderStore store;
+        store.reserve(size);
+        std::vector<std::string> ids;
+        for (std::size_t i = 0; i < size; ++i) {
+            auto o = restingOrder(i);
+            o.orderId = "O" + std::to_string(i);
+            o.status = "NEW";
+            store.insert(o);
+            ids.push_back(o.clOrdId);
+        }
+        constexpr std::size_t kLookups = 1000000;
+        auto ns = bench::nsPerOp(kLookups, [&](std::size_t i) {
+            bench::keep(store.findByClOrdId("FIX.4.4:ACCEPTOR->CLIENT", ids[(i * 7919) % size]));
+        });
+        auto label = "findByClOrdId, " + std::to_string(size) + " orders";
+        bench::report(label.c_str(), ns, "ns/op");
+    }
+}
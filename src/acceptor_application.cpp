@@ -11,12 +11,27 @@
 
 #include <spdlog/spdlog.h>
 
-#include <thread>
 #include <chrono>
-#include <random>
 #include <iostream>
 
 #include "fix_custom.h"
+#include "fix_field.h"
+#include "id_generator.h"
+#include "utc_clock.h"
+
+AcceptorApplication::AcceptorApplication(const AppConfig& config)
+    : traffic_(config.server.traffic_log)
+    , load_test_(config.load_test)
+{
+}
+
+AcceptorApplication::~AcceptorApplication()
+{
+    cancelTestTask();
+    std::lock_guard<std::mutex> lk(test_timers_mtx_);
+    for (auto id : cancelled_timers_)
+        scheduler_->cancel(id);
+}
 
 void AcceptorApplication::onCreate(const FIX::SessionID& sessionID)
 {
@@ -27,155 +42,130 @@ void AcceptorApplication::onLogon(const FIX::SessionID& sessionID)
 {
     SPDLOG_INFO("onLogon:  {}", sessionID.toString());
     session_ = sessionID;
-    startTestTask();
+    if (load_test_.enable)
+        startLoadTest();
+    else
+        startTestTask();
 }
 
 void AcceptorApplication::onLogout(const FIX::SessionID& sessionID)
 {
     SPDLOG_INFO("onLogout: {}", sessionID.toString());
+    // 不在这里等待测试步骤与发送线程：它们可能正阻塞在 sendToTarget 上等待本会话的锁
+    cancelTestTask();
+    if (load_)
+        load_->requestStop();
 }
 
 void AcceptorApplication::toAdmin(FIX::Message& message, const FIX::SessionID& sessionID)
 {
-    SPDLOG_DEBUG("toAdmin:  {}", message.toString());
+    traffic_.message(TrafficFormat::ToAdmin, message);
 }
 
 void AcceptorApplication::fromAdmin(const FIX::Message& message, const FIX::SessionID& sessionID)
 {
-    SPDLOG_DEBUG("fromAdmin:{}", message.toString());
+    traffic_.message(TrafficFormat::FromAdmin, message);
 }
 
 void AcceptorApplication::toApp(FIX::Message& message, const FIX::SessionID& sessionID)
 {
-    SPDLOG_INFO("toApp:    {}", message.toString());
+    traffic_.message(TrafficFormat::ToApp, message);
 }
 
 void AcceptorApplication::fromApp(const FIX::Message& message, const FIX::SessionID& sessionID)
 {
-    SPDLOG_INFO("fromApp:  {}", message.toString());
-    try {
-        FIX::MsgType mt;
-        message.getHeader().getField(mt);
-        if (mt.getValue() == fixcustom::kMsgTypeMarginUpdate) {
-            handleMarginUpdateMessage(message, sessionID);
-            return;
-        }
-    } catch (const std::exception& ex) {
-        SPDLOG_ERROR("fromApp BI check error: {}", ex.what());
+    traffic_.message(TrafficFormat::FromApp, message);
+    const auto* msgType = fixfield::find(message.getHeader(), FIX::FIELD::MsgType);
+    if (msgType && *msgType == fixcustom::MarginUpdateSchema::msgType) {
+        handleMarginUpdateMessage(message, sessionID);
+        return;
     }
     crack(message, sessionID);
 }
 
 void AcceptorApplication::onMessage(const FIX44::ExecutionReport& er, const FIX::SessionID& sessionID)
 {
-    try {
-        FIX::ExecType execType;
-        er.get(execType);
-        FIX::OrdStatus ordStatus;
-        er.get(ordStatus);
-        FIX::ClOrdID clOrdId;
-        if (er.isSetField(clOrdId))
-            er.get(clOrdId);
-        else
-            clOrdId = FIX::ClOrdID("");
-        SPDLOG_INFO(
-            "ER: ClOrdID={}, ExecType={}, OrdStatus={}", clOrdId.getValue(), execType.getValue(), ordStatus.getValue());
-    } catch (const std::exception& ex) {
-        SPDLOG_ERROR("onMessage(ER) error: {}", ex.what());
+    char execType = 0;
+    char ordStatus = 0;
+    std::string clOrdId;
+    auto error = fixfield::Reader(er)
+                     .required(FIX::FIELD::ExecType, execType)
+                     .required(FIX::FIELD::OrdStatus, ordStatus)
+                     .optional(FIX::FIELD::ClOrdID, clOrdId)
+                     .error();
+    if (error) {
+        SPDLOG_ERROR("onMessage(ER) error: {}", fixfield::describe(error));
+        return;
+    }
+    if (load_) {
+        load_->onExecutionReport(clOrdId, execType);
+        return;
     }
+    SPDLOG_INFO("ER: ClOrdID={}, ExecType={}, OrdStatus={}", clOrdId, execType, ordStatus);
 }
 
 void AcceptorApplication::onMessage(const FIX44::OrderCancelReject& rej, const FIX::SessionID& sessionID)
 {
-    try {
-        FIX::ClOrdID clOrdId;
-        if (rej.isSetField(clOrdId))
-            rej.get(clOrdId);
-        else
-            clOrdId = FIX::ClOrdID("");
-        FIX::Text text;
-        if (rej.isSetField(text))
-            rej.get(text);
-        else
-            text = FIX::Text("");
-        SPDLOG_INFO("CxlReject: ClOrdID={}, Text={}", clOrdId.getValue(), text.getValue());
-    } catch (const std::exception& ex) {
-        SPDLOG_ERROR("onMessage(9) error: {}", ex.what());
+    std::string clOrdId;
+    std::string text;
+    fixfield::get(rej, FIX::FIELD::ClOrdID, clOrdId);
+    if (load_) {
+        load_->onCancelReject(clOrdId);
+        return;
     }
+    fixfield::get(rej, FIX::FIELD::Text, text);
+    SPDLOG_INFO("CxlReject: ClOrdID={}, Text={}", clOrdId, text);
 }
 
 void AcceptorApplication::handleMarginUpdateMessage(const FIX::Message& msg, const FIX::SessionID& sessionID)
 {
-    try {
-        std::string account;
-        double marginValue = 0.0;
-        double marginLevel = 0.0;
-        double marginExcess = 0.0;
-        std::string currency;
-
-        if (msg.isSetField(fixcustom::TAG_ACCOUNT)) {
-            FIX::Account acc;
-            msg.getField(acc);
-            account = acc.getValue();
-        }
-        if (msg.isSetField(fixcustom::TAG_MARGIN_VALUE)) {
-            FIX::FieldBase f(fixcustom::TAG_MARGIN_VALUE, "");
-            msg.getField(f);
-            try {
-                marginValue = std::stod(f.getString());
-            } catch (const std::exception& ex) {
-                SPDLOG_ERROR("Failed to parse margin value: {}", f.getString());
-                return;
-            }
-        }
-        if (msg.isSetField(fixcustom::TAG_MARGIN_LEVEL)) {
-            FIX::FieldBase f(fixcustom::TAG_MARGIN_LEVEL, "");
-            msg.getField(f);
-            try {
-                marginLevel = std::stod(f.getString());
-            } catch (const std::exception& ex) {
-                SPDLOG_ERROR("Failed to parse margin level: {}", f.getString());
-                return;
-            }
-        }
-        if (msg.isSetField(fixcustom::TAG_MARGIN_EXCESS)) {
-            FIX::FieldBase f(fixcustom::TAG_MARGIN_EXCESS, "");
-            msg.getField(f);
-            try {
-                marginExcess = std::stod(f.getString());
-            } catch (const std::exception& ex) {
-                SPDLOG_ERROR("Failed to parse margin excess: {}", f.getString());
-                return;
-            }
-        }
-        if (msg.isSetField(fixcustom::TAG_CURRENCY)) {
-            FIX::Currency curr;
-            msg.getField(curr);
-            currency = curr.getValue();
-        }
-
-        SPDLOG_INFO("Received margin update: account={}, marginValue={:.2f}, marginLevel={:.2f}%, marginExcess={:.2f}, "
-                    "currency={}",
-            account, marginValue, marginLevel, marginExcess, currency);
-    } catch (const std::exception& ex) {
-        SPDLOG_ERROR("handleMarginUpdateMessage error: {}", ex.what());
+    common::MarginUpdate update;
+    if (auto error = fixcustom::MarginUpdateSchema::decode(msg, update)) {
+        const auto* value = fixfield::find(msg, error.tag);
+        SPDLOG_ERROR(
+            "Failed to parse margin update: {}: {}", fixfield::describe(error), value ? *value : std::string());
+        return;
     }
+
+    SPDLOG_INFO("Received margin update: account={}, marginValue={:.2f}, marginLevel={:.2f}%, marginExcess={:.2f}, "
+                "currency={}",
+        update.account, update.marginValue.toDouble(), update.marginLevel.toDouble(), update.marginExcess.toDouble(),
+        update.currency);
 }
 
 void AcceptorApplication::startTestTask()
 {
-    std::thread([this]() {
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-        testNewMarketOrder();
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        testNewLimitOrder();
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        testCancelOrder();
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        testReplaceOrder();
-        std::this_thread::sleep_for(std::chrono::seconds(1));
-        testNewnvalidOrder();
-    }).detach();
+    using std::chrono::seconds;
+    // 每一步都是共享定时器上的一次性任务，按到期时间先后在定时器线程上依次执行
+    cancelTestTask();
+    std::lock_guard<std::mutex> lk(test_timers_mtx_);
+    test_timers_ = {
+        scheduler_->scheduleAfter(seconds(2), [this] { testNewMarketOrder(); }),
+        scheduler_->scheduleAfter(seconds(3), [this] { testNewLimitOrder(); }),
+        scheduler_->scheduleAfter(seconds(4), [this] { testCancelOrder(); }),
+        scheduler_->scheduleAfter(seconds(5), [this] { testReplaceOrder(); }),
+        scheduler_->scheduleAfter(seconds(6), [this] { testNewnvalidOrder(); }),
+    };
+}
+
+void AcceptorApplication::startLoadTest()
+{
+    // 重连时上一轮可能还在等待应答，不同时运行两轮
+    if (load_ && load_->running()) {
+        SPDLOG_WARN("Load test still running, not restarted on logon");
+        return;
+    }
+    load_ = std::make_unique<LoadGenerator>(load_test_, session_);
+    load_->start();
+}
+
+void AcceptorApplication::cancelTestTask()
+{
+    std::lock_guard<std::mutex> lk(test_timers_mtx_);
+    for (auto id : test_timers_)
+        scheduler_->cancelNoWait(id);
+    cancelled_timers_.insert(cancelled_timers_.end(), test_timers_.begin(), test_timers_.end());
+    test_timers_.clear();
 }
 
 void AcceptorApplication::testNewMarketOrder()
@@ -189,7 +179,7 @@ void AcceptorApplication::testNewMarketOrder()
         FIX44::NewOrderSingle nos;
         nos.setField(FIX::ClOrdID(clOrdId));
         nos.setField(FIX::Side(FIX::Side_BUY));
-        nos.setField(FIX::TransactTime());
+        nos.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
         nos.setField(FIX::OrdType(FIX::OrdType_MARKET));
         nos.setField(FIX::Symbol("AAPL"));
         nos.setField(FIX::OrderQty(100));
@@ -215,7 +205,7 @@ void AcceptorApplication::testNewLimitOrder()
         FIX44::NewOrderSingle nos;
         nos.setField(FIX::ClOrdID(clOrdId));
         nos.setField(FIX::Side(FIX::Side_SELL));
-        nos.setField(FIX::TransactTime());
+        nos.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
         nos.setField(FIX::OrdType(FIX::OrdType_LIMIT));
         nos.setField(FIX::Symbol("MSFT"));
         nos.setField(FIX::OrderQty(50));
@@ -244,7 +234,7 @@ void AcceptorApplication::testCancelOrder()
         ocr.setField(FIX::OrigClOrdID(lastClOrdId_));
         ocr.setField(FIX::Symbol("AAPL"));
         ocr.setField(FIX::Side(FIX::Side_BUY));
-        ocr.setField(FIX::TransactTime());
+        ocr.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
 
         FIX::Session::sendToTarget(ocr, session_);
         SPDLOG_INFO("Sent cancel request: ClOrdID={}, OrigClOrdID={}", clOrdId, lastClOrdId_);
@@ -269,7 +259,7 @@ void AcceptorApplication::testReplaceOrder()
         ocrr.setField(FIX::OrderQty(200));
         ocrr.setField(FIX::Price(155.50));
         ocrr.setField(FIX::OrdType(FIX::OrdType_LIMIT));
-        ocrr.setField(FIX::TransactTime());
+        ocrr.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
 
         FIX::Session::sendToTarget(ocrr, session_);
         SPDLOG_INFO("Sent replace request: ClOrdID={}, OrigClOrdID={}, Qty=200, Price=155.50", clOrdId, lastClOrdId_);
@@ -289,7 +279,7 @@ void AcceptorApplication::testNewnvalidOrder()
         FIX44::NewOrderSingle nos;
         nos.setField(FIX::ClOrdID(clOrdId));
         nos.setField(FIX::Side(FIX::Side_BUY));
-        nos.setField(FIX::TransactTime());
+        nos.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
         nos.setField(FIX::OrdType(FIX::OrdType_MARKET));
         nos.setField(FIX::Symbol("INVALID"));
         nos.setField(FIX::OrderQty(-10));
@@ -302,8 +292,4 @@ void AcceptorApplication::testNewnvalidOrder()
     }
 }
 
-std::string AcceptorApplication::generateClOrdId()
-{
-    static std::mt19937_64 rng { std::random_device {}() };
-    return std::to_string(rng());
-}
+std::string AcceptorApplication::generateClOrdId() { return std::string(IdGenerator::nextText()); }
@@ -6,10 +6,21 @@
 #include <quickfix/fix44/ExecutionReport.h>
 #include <quickfix/fix44/OrderCancelReject.h>
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include "app_config.h"
+#include "load_generator.h"
+#include "timer_scheduler.h"
+#include "traffic_log.h"
 
 class AcceptorApplication : public FIX::Application, public FIX::MessageCracker {
 public:
+    explicit AcceptorApplication(const AppConfig& config);
+    ~AcceptorApplication() override;
+
     void onCreate(const FIX::SessionID& sessionID) override;
     void onLogon(const FIX::SessionID& sessionID) override;
     void onLogout(const FIX::SessionID& sessionID) override;
@@ -26,6 +37,10 @@ public:
 private:
     //mock sending new order request from BlackArrow to Doo fix engine
     void startTestTask();
+    // [load_test] enable=true 时登录后运行开环压测，代替 startTestTask 的五步测试
+    void startLoadTest();
+    // 不等待正在执行的步骤，可在 QuickFIX 回调内调用；析构时再等待它们结束
+    void cancelTestTask();
     void testNewMarketOrder();
     void testNewLimitOrder();
     void testCancelOrder();
@@ -34,6 +49,14 @@ private:
     static std::string generateClOrdId();
 
     std::string lastClOrdId_;
+    std::shared_ptr<TimerScheduler> scheduler_ { TimerScheduler::shared() };
+    std::mutex test_timers_mtx_;
+    std::vector<TimerId> test_timers_;
+    std::vector<TimerId> cancelled_timers_;
+    TrafficLog traffic_;
+    LoadTestConfig load_test_;
+    // 只在会话线程上（onLogon 与应答回调）访问
+    std::unique_ptr<LoadGenerator> load_;
 
 private:
     FIX::SessionID session_;
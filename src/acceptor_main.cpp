@@ -10,6 +10,9 @@
 
 #include "cc-common/utils.h"
 #include "acceptor_application.h"
+#include "app_config.h"
+#include "id_generator.h"
+#include "utc_clock.h"
 
 int main()
 {
@@ -26,7 +29,10 @@ int main()
         std::string fix_cfg_path = (std::filesystem::current_path() / "Config" / "fix-acceptor.cfg").string();
         // assert_file_exist(fix_cfg_path);
 
-        AcceptorApplication application;
+        AppConfig app_config = loadAppConfig(configuration_path);
+        UtcClock::configure(app_config.server.timestamp);
+        IdGenerator::configure(app_config.server.node_id);
+        AcceptorApplication application(app_config);
         FIX::SessionSettings settings(fix_cfg_path);
         FIX::FileStoreFactory storeFactory(settings);
         FIX::FileLogFactory logFactory(settings);
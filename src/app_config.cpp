@@ -0,0 +1,194 @@
+#include "app_config.h"
+
+#include <boost/property_tree/ini_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+
+namespace {
+
+DomainConfig::ShardKey parseShardKey(const std::string& value)
+{
+    if (value == "account")
+        return DomainConfig::ShardKey::Account;
+    return DomainConfig::ShardKey::Symbol;
+}
+
+EventBusConfig::BackPressure parseBackPressure(const std::string& value)
+{
+    if (value == "drop")
+        return EventBusConfig::BackPressure::Drop;
+    return EventBusConfig::BackPressure::Block;
+}
+
+TimestampConfig::Clock parseTimestampClock(const std::string& value)
+{
+    if (value == "tsc")
+        return TimestampConfig::Clock::Tsc;
+    return TimestampConfig::Clock::System;
+}
+
+// UTCTimestamp 只允许秒、毫秒、微秒、纳秒
+int parseTimestampPrecision(int value)
+{
+    if (value <= 0)
+        return 0;
+    return std::min(9, (value + 2) / 3 * 3);
+}
+
+TrafficLogConfig::Mode parseTrafficLogMode(const std::string& value)
+{
+    if (value == "deferred")
+        return TrafficLogConfig::Mode::Deferred;
+    if (value == "binary")
+        return TrafficLogConfig::Mode::Binary;
+    return TrafficLogConfig::Mode::Sync;
+}
+
+TrafficLogConfig::Verbosity parseVerbosity(const std::string& value)
+{
+    if (value == "off")
+        return TrafficLogConfig::Verbosity::Off;
+    if (value == "summary")
+        return TrafficLogConfig::Verbosity::Summary;
+    return TrafficLogConfig::Verbosity::Full;
+}
+
+// "0:off,A:summary"
+std::unordered_map<std::string, TrafficLogConfig::Verbosity> parseMsgTypes(const std::string& value)
+{
+    std::unordered_map<std::string, TrafficLogConfig::Verbosity> result;
+    std::size_t pos = 0;
+    while (pos < value.size()) {
+        auto end = value.find(',', pos);
+        auto item = value.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        auto colon = item.find(':');
+        if (colon != std::string::npos && colon > 0)
+            result[item.substr(0, colon)] = parseVerbosity(item.substr(colon + 1));
+        if (end == std::string::npos)
+            break;
+        pos = end + 1;
+    }
+    return result;
+}
+
+// "AAPL,MSFT"，忽略空项
+std::vector<std::string> parseList(const std::string& value)
+{
+    std::vector<std::string> result;
+    std::size_t pos = 0;
+    while (pos <= value.size()) {
+        auto end = value.find(',', pos);
+        auto item = value.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        if (!item.empty())
+            result.push_back(std::move(item));
+        if (end == std::string::npos)
+            break;
+        pos = end + 1;
+    }
+    return result;
+}
+
+// "market:20,limit:50,cancel:15,replace:10,invalid:5"，未列出的类型权重为 0
+std::array<std::uint32_t, LoadTestConfig::KindCount> parseLoadMix(const std::string& value)
+{
+    static const char* const kNames[] = { "market", "limit", "cancel", "replace", "invalid" };
+    std::array<std::uint32_t, LoadTestConfig::KindCount> mix {};
+    for (const auto& item : parseList(value)) {
+        auto colon = item.find(':');
+        if (colon == std::string::npos)
+            continue;
+        auto name = item.substr(0, colon);
+        for (int k = 0; k < LoadTestConfig::KindCount; ++k) {
+            if (name == kNames[k])
+                mix[k] = static_cast<std::uint32_t>(std::stoul(item.substr(colon + 1)));
+        }
+    }
+    return mix;
+}
+
+RiskLimits parseRiskLimits(const boost::property_tree::ptree& pt, const RiskLimits& defaults)
+{
+    RiskLimits limits;
+    limits.max_order_qty = pt.get<double>("max_order_qty", defaults.max_order_qty);
+    limits.max_order_notional = pt.get<double>("max_order_notional", defaults.max_order_notional);
+    limits.max_open_orders = pt.get<std::uint32_t>("max_open_orders", defaults.max_open_orders);
+    limits.max_msgs_per_sec = pt.get<std::uint32_t>("max_msgs_per_sec", defaults.max_msgs_per_sec);
+    limits.price_band = pt.get<double>("price_band", defaults.price_band);
+    return limits;
+}
+
+} // namespace
+
+AppConfig loadAppConfig(const std::string& path)
+{
+    boost::property_tree::ptree pt;
+    boost::property_tree::read_ini(path, pt);
+
+    AppConfig cfg;
+    cfg.server.disable_idempotence = pt.get<bool>("server.disable_idempotence", false);
+    cfg.server.pipeline = pt.get<bool>("server.pipeline", false);
+    cfg.server.pipeline_queue = std::max<std::size_t>(2, pt.get<std::size_t>("server.pipeline_queue", 65536));
+    cfg.server.pipeline_metrics_interval_s = pt.get<std::uint32_t>("server.pipeline_metrics_interval_s", 60);
+    cfg.server.node_id = std::min<std::uint32_t>(1023, pt.get<std::uint32_t>("server.node_id", 0));
+    cfg.server.timestamp.clock = parseTimestampClock(pt.get<std::string>("server.timestamp_clock", "system"));
+    cfg.server.timestamp.precision = parseTimestampPrecision(pt.get<int>("server.timestamp_precision", 3));
+
+    auto& traffic = cfg.server.traffic_log;
+    traffic.mode = parseTrafficLogMode(pt.get<std::string>("traffic_log.mode", "sync"));
+    traffic.verbosity = parseVerbosity(pt.get<std::string>("traffic_log.verbosity", "full"));
+    traffic.msg_types = parseMsgTypes(pt.get<std::string>("traffic_log.msg_types", ""));
+    traffic.sample_every = std::max<std::uint32_t>(1, pt.get<std::uint32_t>("traffic_log.sample_every", 1));
+    traffic.ring_kb = std::max<std::size_t>(4, pt.get<std::size_t>("traffic_log.ring_kb", 1024));
+    traffic.file = pt.get<std::string>("traffic_log.file", "traffic.bin");
+
+    cfg.domain.shard_count = std::max<std::size_t>(1, pt.get<std::size_t>("domain.shard_count", 1));
+    cfg.domain.shard_key = parseShardKey(pt.get<std::string>("domain.shard_key", "symbol"));
+    cfg.domain.hot_order_cap = pt.get<std::size_t>("domain.hot_order_cap", 0);
+
+    auto& journal = cfg.domain.journal;
+    journal.enable = pt.get<bool>("journal.enable", false);
+    journal.dir = pt.get<std::string>("journal.dir", "journal");
+    journal.segment_mb = std::max<std::size_t>(1, pt.get<std::size_t>("journal.segment_mb", 64));
+    journal.flush_interval_ms = std::max<std::uint32_t>(1, pt.get<std::uint32_t>("journal.flush_interval_ms", 2));
+    journal.snapshot_interval_s = pt.get<std::uint32_t>("journal.snapshot_interval_s", 300);
+
+    auto& margin = cfg.domain.margin;
+    margin.balance = pt.get<double>("margin.balance", 100000.0);
+    auto leverage = pt.get<double>("margin.leverage", 100.0);
+    margin.leverage = leverage > 0 ? leverage : 100.0;
+    margin.currency = pt.get<std::string>("margin.currency", "USD");
+    margin.publish_interval_s = std::max<std::uint32_t>(1, pt.get<std::uint32_t>("margin.publish_interval_s", 30));
+
+    auto& risk = cfg.domain.risk;
+    if (auto section = pt.get_child_optional("risk"))
+        risk.defaults = parseRiskLimits(*section, risk.defaults);
+    static const std::string kAccountPrefix = "risk:";
+    for (const auto& [name, section] : pt) {
+        if (name.size() > kAccountPrefix.size() && name.compare(0, kAccountPrefix.size(), kAccountPrefix) == 0)
+            risk.accounts[name.substr(kAccountPrefix.size())] = parseRiskLimits(section, risk.defaults);
+    }
+
+    auto& events = cfg.domain.events;
+    events.capacity = std::max<std::size_t>(2, pt.get<std::size_t>("events.capacity", 65536));
+    events.back_pressure = parseBackPressure(pt.get<std::string>("events.back_pressure", "block"));
+
+    auto& load = cfg.load_test;
+    load.enable = pt.get<bool>("load_test.enable", false);
+    load.rate = std::max<std::uint32_t>(1, pt.get<std::uint32_t>("load_test.rate", 1000));
+    load.duration_s = std::max<std::uint32_t>(1, pt.get<std::uint32_t>("load_test.duration_s", 30));
+    load.drain_s = pt.get<std::uint32_t>("load_test.drain_s", 5);
+    if (auto mix = pt.get_optional<std::string>("load_test.mix")) {
+        load.mix = parseLoadMix(*mix);
+        if (std::all_of(load.mix.begin(), load.mix.end(), [](std::uint32_t w) { return w == 0; }))
+            load.mix = LoadTestConfig {}.mix;
+    }
+    if (auto symbols = parseList(pt.get<std::string>("load_test.symbols", "")); !symbols.empty())
+        load.symbols = std::move(symbols);
+    if (auto accounts = parseList(pt.get<std::string>("load_test.accounts", "")); !accounts.empty())
+        load.accounts = std::move(accounts);
+    auto price = pt.get<double>("load_test.price", 100.0);
+    load.price = price > 0 ? price : 100.0;
+    load.report_file = pt.get<std::string>("load_test.report_file", "");
+    return cfg;
+}
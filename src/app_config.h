@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 订单日志：开启后订单写入内存映射日志，重启时由快照 + 日志尾部恢复
+struct JournalConfig {
+    bool enable { false };
+    std::string dir { "journal" };
+    std::size_t segment_mb { 64 };
+    // 后台落盘间隔，即崩溃时最多丢失的时间窗口
+    std::uint32_t flush_interval_ms { 2 };
+    std::uint32_t snapshot_interval_s { 300 };
+};
+
+// 保证金：所有账户使用相同的初始净值与杠杆
+struct MarginConfig {
+    double balance { 100000.0 };
+    double leverage { 100.0 };
+    std::string currency { "USD" };
+    // 推送有变化账户的保证金的间隔
+    std::uint32_t publish_interval_s { 30 };
+};
+
+// 单个账户的事前风控限额，0 表示不限制
+struct RiskLimits {
+    double max_order_qty { 0 };
+    double max_order_notional { 0 };
+    std::uint32_t max_open_orders { 0 };
+    // 每秒 NewOrderSingle/改单请求数（滑动窗口）
+    std::uint32_t max_msgs_per_sec { 0 };
+    // 限价偏离该品种参考价（最近一次接受的限价）的最大比例，例如 0.1 = ±10%
+    double price_band { 0 };
+};
+
+// [risk] 为默认限额，[risk:<账户>] 为单个账户的限额（未配置的项沿用默认值）
+struct RiskConfig {
+    RiskLimits defaults;
+    std::unordered_map<std::string, RiskLimits> accounts;
+};
+
+// 订单事件总线：每个订阅者一个有界队列
+struct EventBusConfig {
+    enum class BackPressure { Block, Drop };
+
+    std::size_t capacity { 65536 };
+    // 订阅者队列满时：block = 发布方等待；drop = 丢弃该订阅者的这条事件并计数。
+    // drop 只作用于回报推送等可丢的订阅者，保证金订阅者总是 block
+    BackPressure back_pressure { BackPressure::Block };
+};
+
+// [traffic_log] FIX 报文与热路径日志
+struct TrafficLogConfig {
+    // sync = 调用线程上直接写 spdlog；deferred = 写入线程本地环形缓冲，由后台线程格式化；
+    // binary = 后台线程原样写入 file，离线解码
+    enum class Mode { Sync, Deferred, Binary };
+    // summary = 只记 MsgType / MsgSeqNum / ClOrdID
+    enum class Verbosity { Off, Summary, Full };
+
+    Mode mode { Mode::Sync };
+    Verbosity verbosity { Verbosity::Full };
+    // 按 MsgType 覆盖 verbosity
+    std::unordered_map<std::string, Verbosity> msg_types;
+    // 每种消息每 N 条记录 1 条
+    std::uint32_t sample_every { 1 };
+    // 每个写入线程的环形缓冲大小
+    std::size_t ring_kb { 1024 };
+    std::string file { "traffic.bin" };
+};
+
+// 出站报文的 UTC 时间戳（TransactTime 等）
+struct TimestampConfig {
+    // system = system_clock（Linux 上为 vDSO clock_gettime）；tsc = 按 system_clock 校准的 TSC 外推，仅 x86
+    enum class Clock { System, Tsc };
+
+    Clock clock { Clock::System };
+    // 小数位数：0 / 3 / 6 / 9
+    int precision { 3 };
+};
+
+// [server] 会话层配置
+struct ServerConfig {
+    // false：同一会话同一交易日内重复的 ClOrdID 被拒绝
+    bool disable_idempotence { false };
+    // true：收到的应用消息只在 QuickFIX 线程上入队，解码与领域处理各由独立的流水线线程完成；
+    // 应答（执行回报与拒绝）与非流水线模式相同，统一由事件总线的 fix-reporter 线程发送
+    bool pipeline { false };
+    std::size_t pipeline_queue { 65536 };
+    // 流水线各级队列深度与延迟的日志间隔，0 表示不输出
+    std::uint32_t pipeline_metrics_interval_s { 60 };
+    // OrderID / ExecID / ClOrdID 中的节点号 0~1023，同时运行的多个进程实例须各不相同
+    std::uint32_t node_id { 0 };
+    TimestampConfig timestamp;
+    TrafficLogConfig traffic_log;
+};
+
+// black-arrow-common.ini 中与业务相关的配置项
+struct DomainConfig {
+    enum class ShardKey { Symbol, Account };
+
+    // 1 = 单锁内联模式；>1 = 分片模式，每个分片由独立的工作线程串行处理。
+    // 开启日志时分片数与路由键记录在日志目录中，重启时不得改变
+    std::size_t shard_count { 1 };
+    ShardKey shard_key { ShardKey::Symbol };
+    // 热存储订单数上限（所有分片合计），超过后最早的终态订单移入冷存储；0 表示不淘汰。
+    // 只限制热存储：ClOrdID/OrderID 文本留在只追加的文本区中不回收（冷存储记录仍引用），
+    // 随累计订单数增长，每个分片上限 4 GiB，超出后新订单被拒绝
+    std::size_t hot_order_cap { 0 };
+    JournalConfig journal;
+    MarginConfig margin;
+    RiskConfig risk;
+    EventBusConfig events;
+};
+
+// [load_test] acceptor 端的开环压测：登录后按固定速率发单，替代内置的五步测试
+struct LoadTestConfig {
+    // 请求类型，即 mix 的下标
+    enum Kind { Market, Limit, Cancel, Replace, Invalid, KindCount };
+
+    bool enable { false };
+    // 每秒请求数；发送时刻按速率预先排定，不等待应答（开环）
+    std::uint32_t rate { 1000 };
+    std::uint32_t duration_s { 30 };
+    // 发送结束后等待应答的时间，仍未应答的请求计为丢失
+    std::uint32_t drain_s { 5 };
+    // 各类请求的权重；没有可撤/改的挂单时，撤单与改单改发限价单
+    std::array<std::uint32_t, KindCount> mix { 20, 50, 15, 10, 5 };
+    std::vector<std::string> symbols { "AAPL", "MSFT", "GOOG", "AMZN" };
+    std::vector<std::string> accounts { "LOAD-001", "LOAD-002", "LOAD-003", "LOAD-004" };
+    // 限价单围绕该价格上下 1%~3% 挂出，买卖不交叉
+    double price { 100.0 };
+    // 非空时结束后把完整的延迟分布写入该文件
+    std::string report_file;
+};
+
+struct AppConfig {
+    ServerConfig server;
+    DomainConfig domain;
+    LoadTestConfig load_test;
+};
+
+// 读取 ini 配置；缺失的键使用默认值，文件无法解析时抛出异常
+AppConfig loadAppConfig(const std::string& path);
@@ -0,0 +1,108 @@
+#include "clordid_filter.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+namespace {
+
+// 布隆过滤器：每个槽位 2 字节（负载 <= 1/2 时每个键至少 32 位），每个键在同一块内置 4 位
+constexpr std::size_t kSlotsPerBloomBlock = 32;
+constexpr int kBloomBits = 4;
+
+} // namespace
+
+ClOrdIdFilter::ClOrdIdFilter(std::size_t expected)
+    : slots_(std::bit_ceil(std::max<std::size_t>(expected * 2, 1024)))
+    , bloom_(slots_.size() / kSlotsPerBloomBlock)
+{
+}
+
+bool ClOrdIdFilter::insert(std::string_view clOrdId)
+{
+    auto hash = hashOf(clOrdId);
+    if (bloomMayContain(hash) && findExact(hash, clOrdId))
+        return false;
+    if ((count_ + 1) * 2 > slots_.size())
+        grow();
+    place(hash, text_.append(clOrdId));
+    bloomAdd(hash);
+    ++count_;
+    return true;
+}
+
+bool ClOrdIdFilter::contains(std::string_view clOrdId) const
+{
+    auto hash = hashOf(clOrdId);
+    return bloomMayContain(hash) && findExact(hash, clOrdId);
+}
+
+std::size_t ClOrdIdFilter::memoryBytes() const
+{
+    return slots_.capacity() * sizeof(Slot) + bloom_.capacity() * sizeof(BloomBlock) + text_.bytesUsed();
+}
+
+std::uint64_t ClOrdIdFilter::hashOf(std::string_view clOrdId)
+{
+    // 混合一次再置最低位，保证非零且高低位都均匀
+    std::uint64_t h = std::hash<std::string_view> {}(clOrdId);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h | 1;
+}
+
+bool ClOrdIdFilter::bloomMayContain(std::uint64_t hash) const
+{
+    const auto& block = bloom_[(hash >> 40) & (bloom_.size() - 1)];
+    for (int i = 0; i < kBloomBits; ++i) {
+        auto bit = (hash >> (1 + i * 9)) & 511;
+        if (!(block.words[bit >> 6] & (std::uint64_t { 1 } << (bit & 63))))
+            return false;
+    }
+    return true;
+}
+
+void ClOrdIdFilter::bloomAdd(std::uint64_t hash)
+{
+    auto& block = bloom_[(hash >> 40) & (bloom_.size() - 1)];
+    for (int i = 0; i < kBloomBits; ++i) {
+        auto bit = (hash >> (1 + i * 9)) & 511;
+        block.words[bit >> 6] |= std::uint64_t { 1 } << (bit & 63);
+    }
+}
+
+bool ClOrdIdFilter::findExact(std::uint64_t hash, std::string_view clOrdId) const
+{
+    auto mask = slots_.size() - 1;
+    for (auto i = hash & mask;; i = (i + 1) & mask) {
+        const auto& slot = slots_[i];
+        if (slot.hash == 0)
+            return false;
+        if (slot.hash == hash && text_.view(slot.text) == clOrdId)
+            return true;
+    }
+}
+
+void ClOrdIdFilter::place(std::uint64_t hash, TextRef text)
+{
+    auto mask = slots_.size() - 1;
+    auto i = hash & mask;
+    while (slots_[i].hash != 0)
+        i = (i + 1) & mask;
+    slots_[i] = { hash, text };
+}
+
+void ClOrdIdFilter::grow()
+{
+    // 槽位里保存了完整哈希值，扩容时无需重新读取文本，布隆过滤器按新的大小重建
+    std::vector<Slot> old(slots_.size() * 2);
+    old.swap(slots_);
+    bloom_.assign(slots_.size() / kSlotsPerBloomBlock, BloomBlock {});
+    for (const auto& slot : old) {
+        if (slot.hash == 0)
+            continue;
+        place(slot.hash, slot.text);
+        bloomAdd(slot.hash);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "string_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// ClOrdID 去重集合（单个会话、单个交易日）。
+// 精确集合是开放寻址表，槽位只存哈希值与文本引用，文本放在 TextArena 中，不为每个 ClOrdID 单独分配内存；
+// 表前面是分块布隆过滤器（每个键只访问一条缓存行）：新 ClOrdID 几乎总被判定为"一定不存在"，
+// 插入时不必做任何字符串比较，只有布隆命中时才在精确集合中逐个比较。
+// 非线程安全。
+class ClOrdIdFilter {
+public:
+    explicit ClOrdIdFilter(std::size_t expected = 1 << 16);
+
+    ClOrdIdFilter(const ClOrdIdFilter&) = delete;
+    ClOrdIdFilter& operator=(const ClOrdIdFilter&) = delete;
+
+    // 首次出现时记录并返回 true，重复时返回 false
+    bool insert(std::string_view clOrdId);
+    bool contains(std::string_view clOrdId) const;
+
+    std::size_t size() const { return count_; }
+    std::size_t memoryBytes() const;
+
+private:
+    struct Slot {
+        std::uint64_t hash { 0 }; // 0 表示空槽
+        TextRef text;
+    };
+
+    struct alignas(64) BloomBlock {
+        std::uint64_t words[8] {};
+    };
+
+    static std::uint64_t hashOf(std::string_view clOrdId);
+    bool bloomMayContain(std::uint64_t hash) const;
+    void bloomAdd(std::uint64_t hash);
+    bool findExact(std::uint64_t hash, std::string_view clOrdId) const;
+    void place(std::uint64_t hash, TextRef text);
+    void grow();
+
+private:
+    std::vector<Slot> slots_;
+    std::size_t count_ { 0 };
+    std::vector<BloomBlock> bloom_;
+    TextArena text_;
+};
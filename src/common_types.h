@@ -1,9 +1,56 @@
 #pragma once
 
+#include "decimal.h"
+
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace common {
 
+// 内部订单状态机；common::Order::status 作为边界类型仍使用 FIX 风格的文本
+enum class OrderState : std::uint8_t { New, Canceled, Replaced, PartiallyFilled, Filled };
+
+inline const char* toString(OrderState state)
+{
+    switch (state) {
+    case OrderState::New:
+        return "NEW";
+    case OrderState::Canceled:
+        return "CANCELED";
+    case OrderState::Replaced:
+        return "REPLACED";
+    case OrderState::PartiallyFilled:
+        return "PARTIALLY_FILLED";
+    case OrderState::Filled:
+        return "FILLED";
+    }
+    return "NEW";
+}
+
+// 挂单中（仍可成交、撤单、改单）
+inline bool isOpen(OrderState state) { return state == OrderState::New || state == OrderState::PartiallyFilled; }
+inline bool isTerminal(OrderState state) { return !isOpen(state); }
+
+inline OrderState parseOrderState(const std::string& status)
+{
+    if (status == "CANCELED")
+        return OrderState::Canceled;
+    if (status == "REPLACED")
+        return OrderState::Replaced;
+    if (status == "PARTIALLY_FILLED")
+        return OrderState::PartiallyFilled;
+    if (status == "FILLED")
+        return OrderState::Filled;
+    return OrderState::New;
+}
+
+// 内部定点数：数量与价格按 1e-8 精度存放为 int64（即 Fixed::raw()）
+inline constexpr std::int64_t kFixedScale = Fixed::kScale;
+
+inline std::int64_t toFixed(double value) { return Fixed::fromDouble(value).raw(); }
+inline double fromFixed(std::int64_t value) { return Fixed::fromRaw(value).toDouble(); }
+
 struct Order {
     std::string orderId;
     std::string clOrdId;
@@ -14,7 +61,24 @@ struct Order {
     double price { 0.0 };
     char timeInForce { '0' }; // FIX TIF (0=Day,...)
     std::string account;
-    std::string status; // NEW/CANCELED/REPLACED
+    std::string status; // NEW/PARTIALLY_FILLED/FILLED/CANCELED/REPLACED
+    double cumQty { 0.0 };
+    double avgPx { 0.0 };
+    std::string session; // 下单会话（FIX SessionID 文本），该订单的执行回报发往此会话
+};
+
+// 一条执行回报：撮合成交（ExecType F）或未成交部分被撤销（ExecType 4）；
+// ExecType 5 为改单确认，order 为替换订单；
+// ExecType 8 表示请求被拒绝，order 只带 ClOrdID 与会话，以 OrderCancelReject 发出
+struct Execution {
+    Order order; // 回报后的订单（cumQty/avgPx/status 已更新）
+    std::string execId;
+    std::string execType;
+    std::string ordStatus;
+    double lastQty { 0.0 };
+    double lastPx { 0.0 };
+    std::string text {}; // 拒绝原因
+    std::string origClOrdId {}; // 改单确认带原订单的 ClOrdID
 };
 
 struct OrderResult {
@@ -23,13 +87,14 @@ struct OrderResult {
     std::string execId;
     std::string message;
     Order updatedOrder; // echo/back
+    std::vector<Execution> executions {}; // 新订单撮合产生的回报，按发生顺序，须在确认之后发送
 };
 
 struct MarginUpdate {
     std::string account;
-    double marginValue { 0.0 };
-    double marginLevel { 0.0 };
-    double marginExcess { 0.0 };
+    Money marginValue;
+    Money marginLevel; // 百分比
+    Money marginExcess;
     std::string currency;
 };
 
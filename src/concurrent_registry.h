@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+// 按字符串键惰性创建、永不删除的对象表。桶数固定，每个桶是只在表头插入的单链表：
+// 节点发布后不再修改也不删除，查找只做一次原子读和链表遍历，不加锁；
+// 新键以 CAS 插入表头，两个线程同时插入同一个键时，CAS 失败的一方重新查找并丢弃自己的节点。
+// 返回的引用在表的生命周期内保持有效。
+// 线程安全。
+template <typename T, std::size_t Buckets = 4096>
+class ConcurrentRegistry {
+public:
+    ConcurrentRegistry() = default;
+    ~ConcurrentRegistry()
+    {
+        for (auto& head : buckets_) {
+            for (auto* node = head.load(std::memory_order_relaxed); node;)
+                delete std::exchange(node, node->next);
+        }
+    }
+
+    ConcurrentRegistry(const ConcurrentRegistry&) = delete;
+    ConcurrentRegistry& operator=(const ConcurrentRegistry&) = delete;
+
+    T& get(const std::string& key)
+    {
+        return get(key, [](T&) {});
+    }
+
+    // 首次出现的键先用 init 初始化，再对其他线程可见
+    template <typename Init>
+    T& get(const std::string& key, Init&& init)
+    {
+        auto& head = buckets_[std::hash<std::string> {}(key) % Buckets];
+        auto* first = head.load(std::memory_order_acquire);
+        if (auto* node = find(first, nullptr, key))
+            return node->value;
+        auto fresh = std::make_unique<Node>(key);
+        init(fresh->value);
+        for (;;) {
+            fresh->next = first;
+            if (head.compare_exchange_weak(first, fresh.get(), std::memory_order_release, std::memory_order_acquire))
+                return fresh.release()->value;
+            // 只需检查其他线程新插入的节点
+            if (auto* node = find(first, fresh->next, key))
+                return node->value;
+        }
+    }
+
+private:
+    struct Node {
+        explicit Node(const std::string& k)
+            : key(k)
+        {
+        }
+
+        const std::string key;
+        T value;
+        Node* next { nullptr };
+    };
+
+    // [node, end) 中查找
+    static Node* find(Node* node, const Node* end, const std::string& key)
+    {
+        for (; node != end; node = node->next) {
+            if (node->key == key)
+                return node;
+        }
+        return nullptr;
+    }
+
+    std::array<std::atomic<Node*>, Buckets> buckets_ {};
+};
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+namespace common {
+
+namespace detail {
+
+constexpr std::int64_t pow10(int n)
+{
+    std::int64_t v = 1;
+    while (n-- > 0)
+        v *= 10;
+    return v;
+}
+
+// 运行期按位数取 10 的幂
+inline constexpr std::uint64_t kPow10[] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL };
+
+} // namespace detail
+
+// 十进制定点数：int64 存放 value * 10^Decimals。
+// 文本编解码与 std::to_chars / from_chars 同样的接口，只用栈上缓冲，不分配内存、不依赖 locale；
+// 同一文本在任何平台上解析出相同的值，加减比较都是精确的整数运算。
+template <int Decimals>
+class Decimal {
+public:
+    static_assert(Decimals >= 0 && Decimals <= 18, "Decimal: unsupported scale");
+    static constexpr int kDecimals = Decimals;
+    static constexpr std::int64_t kScale = detail::pow10(Decimals);
+    // 文本最长：符号 + 19 位数字 + 小数点
+    static constexpr std::size_t kMaxChars = 21;
+
+    constexpr Decimal() = default;
+
+    static constexpr Decimal fromRaw(std::int64_t raw)
+    {
+        Decimal d;
+        d.raw_ = raw;
+        return d;
+    }
+    // 四舍五入到 Decimals 位
+    static Decimal fromDouble(double value) { return fromRaw(static_cast<std::int64_t>(std::llround(value * kScale))); }
+
+    constexpr std::int64_t raw() const { return raw_; }
+    double toDouble() const { return static_cast<double>(raw_) / kScale; }
+
+    // 换算到另一精度，位数减少时四舍五入（远离 0）
+    template <int Other>
+    constexpr Decimal<Other> rescale() const
+    {
+        if constexpr (Other >= Decimals) {
+            return Decimal<Other>::fromRaw(raw_ * detail::pow10(Other - Decimals));
+        } else {
+            constexpr auto kDiv = detail::pow10(Decimals - Other);
+            auto half = raw_ < 0 ? -kDiv / 2 : kDiv / 2;
+            return Decimal<Other>::fromRaw((raw_ + half) / kDiv);
+        }
+    }
+
+    // 解析 [first, last) 开头的十进制文本，可带 '-'，不接受 '+'、指数和空白；
+    // 超出 Decimals 的小数位四舍五入。与 from_chars 一样遇到第一个非数字字符停止，ptr 指向它；
+    // 没有数字时返回 invalid_argument，超出范围时返回 result_out_of_range，出错时不修改 out
+    static std::from_chars_result fromChars(const char* first, const char* last, Decimal& out) noexcept
+    {
+        constexpr auto kMax = std::numeric_limits<std::int64_t>::max();
+        const char* p = first;
+        bool negative = p < last && *p == '-';
+        if (negative)
+            ++p;
+        std::int64_t integer = 0;
+        std::int64_t fraction = 0;
+        int decimals = 0;
+        bool dot = false;
+        bool digits = false;
+        bool roundUp = false;
+        for (; p < last; ++p) {
+            char c = *p;
+            if (c == '.' && !dot) {
+                dot = true;
+                continue;
+            }
+            if (c < '0' || c > '9')
+                break;
+            digits = true;
+            int d = c - '0';
+            if (!dot) {
+                // 留出小数部分与进位的余量
+                if (integer > (kMax / kScale - 1 - d) / 10)
+                    return { p, std::errc::result_out_of_range };
+                integer = integer * 10 + d;
+            } else if (decimals < Decimals) {
+                fraction = fraction * 10 + d;
+                ++decimals;
+            } else if (decimals == Decimals) {
+                roundUp = d >= 5;
+                ++decimals;
+            }
+        }
+        if (!digits)
+            return { first, std::errc::invalid_argument };
+        for (int i = decimals < Decimals ? decimals : Decimals; i < Decimals; ++i)
+            fraction *= 10;
+        auto value = integer * kScale + fraction + (roundUp ? 1 : 0);
+        out.raw_ = negative ? -value : value;
+        return { p, std::errc() };
+    }
+
+    // 整段文本都须是合法的十进制数，失败时不修改 out
+    static bool parse(std::string_view text, Decimal& out) noexcept
+    {
+        const char* last = text.data() + text.size();
+        Decimal value;
+        auto [ptr, ec] = fromChars(text.data(), last, value);
+        if (ec != std::errc() || ptr != last)
+            return false;
+        out = value;
+        return true;
+    }
+
+    // 最短表示：去掉小数末尾的 0，整数不带小数点
+    std::to_chars_result toChars(char* first, char* last) const noexcept
+    {
+        return format<true>(first, last, Decimals);
+    }
+
+    // 固定 decimals 位小数（不超过 Decimals），多余的位四舍五入，相当于 "%.Nf"
+    std::to_chars_result toChars(char* first, char* last, int decimals) const noexcept
+    {
+        return format<false>(first, last, decimals < 0 ? 0 : decimals < Decimals ? decimals : Decimals);
+    }
+
+    constexpr Decimal operator-() const { return fromRaw(-raw_); }
+    constexpr Decimal& operator+=(Decimal other)
+    {
+        raw_ += other.raw_;
+        return *this;
+    }
+    constexpr Decimal& operator-=(Decimal other)
+    {
+        raw_ -= other.raw_;
+        return *this;
+    }
+    friend constexpr Decimal operator+(Decimal a, Decimal b) { return a += b; }
+    friend constexpr Decimal operator-(Decimal a, Decimal b) { return a -= b; }
+    friend constexpr auto operator<=>(const Decimal&, const Decimal&) = default;
+
+private:
+    // Trim：去掉小数末尾的 0
+    template <bool Trim>
+    std::to_chars_result format(char* first, char* last, int decimals) const noexcept
+    {
+        // 空间足够时直接写入调用方缓冲，否则先写到栈上再检查长度
+        if (static_cast<std::size_t>(last - first) >= kMaxChars)
+            return { write<Trim>(first, decimals), std::errc() };
+        char buf[kMaxChars];
+        auto size = static_cast<std::size_t>(write<Trim>(buf, decimals) - buf);
+        if (static_cast<std::size_t>(last - first) < size)
+            return { last, std::errc::value_too_large };
+        std::memcpy(first, buf, size);
+        return { first + size, std::errc() };
+    }
+
+    // out 至少 kMaxChars 字节，返回写入的末尾
+    template <bool Trim>
+    char* write(char* out, int decimals) const noexcept
+    {
+        char* p = out;
+        auto magnitude = raw_ < 0 ? 0 - static_cast<std::uint64_t>(raw_) : static_cast<std::uint64_t>(raw_);
+        if (decimals < Decimals) {
+            auto div = detail::kPow10[Decimals - decimals];
+            magnitude = (magnitude + div / 2) / div;
+        }
+        auto scale = detail::kPow10[decimals];
+        if (raw_ < 0 && magnitude != 0)
+            *p++ = '-';
+        p = std::to_chars(p, out + kMaxChars, magnitude / scale).ptr;
+        auto fraction = magnitude % scale;
+        if (decimals > 0 && (!Trim || fraction != 0)) {
+            char digits[18];
+            for (int i = decimals - 1; i >= 0; --i) {
+                digits[i] = static_cast<char>('0' + fraction % 10);
+                fraction /= 10;
+            }
+            int n = decimals;
+            while (Trim && digits[n - 1] == '0')
+                --n;
+            *p++ = '.';
+            std::memcpy(p, digits, static_cast<std::size_t>(n));
+            p += n;
+        }
+        return p;
+    }
+
+private:
+    std::int64_t raw_ { 0 };
+};
+
+// 数量与价格（1e-8），与存储、撮合使用的定点数一致
+using Fixed = Decimal<8>;
+// 金额（保证金、净值等，1e-2）
+using Money = Decimal<2>;
+
+} // namespace common
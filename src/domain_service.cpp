@@ -4,14 +4,128 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
 
-DomainService::DomainService() { }
-DomainService::~DomainService() { stopMarginUpdates(); }
+#include "id_generator.h"
+
+namespace {
+
+// 内部订单状态对应的 FIX OrdStatus
+const char* ordStatusOf(common::OrderState state)
+{
+    switch (state) {
+    case common::OrderState::New:
+        return "0";
+    case common::OrderState::PartiallyFilled:
+        return "1";
+    case common::OrderState::Filled:
+        return "2";
+    case common::OrderState::Canceled:
+        return "4";
+    case common::OrderState::Replaced:
+        return "5";
+    }
+    return "0";
+}
+
+} // namespace
+
+DomainService::DomainService(const DomainConfig& config, std::shared_ptr<TimerScheduler> scheduler)
+    : config_(config)
+    , margin_(config.margin)
+    , risk_(config.risk)
+    , scheduler_(std::move(scheduler))
+    , events_(config.events)
+{
+    // 保证金由订单事件异步维护，不占用下单路径；按事件增量累加，丢一条账户敞口就一直是错的，因此不可丢
+    events_.subscribe("margin", [this](const common::Execution& e) { applyMarginEvent(e); }, true);
+
+    auto count = std::max<std::size_t>(1, config_.shard_count);
+    // 热存储上限按分片均分
+    auto hot_cap = config_.hot_order_cap == 0 ? 0 : (config_.hot_order_cap + count - 1) / count;
+    shards_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->orders.setHotCapacity(hot_cap);
+        if (config_.journal.enable)
+            shard->journal = std::make_unique<OrderJournal>(config_.journal.dir, i, config_.journal.segment_mb << 20);
+        shards_.push_back(std::move(shard));
+    }
+    if (config_.journal.enable) {
+        recoverJournals();
+        // 恢复出的挂单重新计入风控与保证金，并按 OrderID 顺序（即时间优先顺序）挂回订单簿
+        std::vector<std::pair<std::uint64_t, common::Order>> resting;
+        snapshot().forEach({}, [&](const common::Order& o) {
+            if (!common::isOpen(common::parseOrderState(o.status)))
+                return;
+            risk_.onOrderRecovered(o);
+            margin_.onOrderOpened(o);
+            if (restsInBook(o.orderType, o.timeInForce))
+                resting.emplace_back(bookId(o.orderId), o);
+        });
+        std::sort(resting.begin(), resting.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& [id, o] : resting)
+            matching_.restore(o.symbol, bookRequest(o));
+    }
+    if (count > 1) {
+        for (auto& shard : shards_) {
+            shard->worker = std::make_unique<ShardWorker>();
+            shard->worker->start();
+        }
+    }
+    // 定时任务会进入分片上下文，须在工作线程就绪之后注册
+    if (config_.journal.enable) {
+        journal_flush_timer_ = scheduler_->scheduleEvery(
+            std::chrono::milliseconds(config_.journal.flush_interval_ms), [this] { flushJournals(); });
+        if (config_.journal.snapshot_interval_s > 0) {
+            journal_snapshot_timer_ = scheduler_->scheduleEvery(
+                std::chrono::seconds(config_.journal.snapshot_interval_s), [this] { snapshotJournals(); });
+        }
+    }
+    SPDLOG_INFO("DomainService started with {} shard(s), key={}", count,
+        config_.shard_key == DomainConfig::ShardKey::Account ? "account" : "symbol");
+}
+
+DomainService::~DomainService()
+{
+    stopMarginUpdates();
+    scheduler_->cancel(margin_timer_);
+    scheduler_->cancel(journal_flush_timer_);
+    scheduler_->cancel(journal_snapshot_timer_);
+    for (auto& shard : shards_) {
+        if (shard->worker)
+            shard->worker->stop();
+    }
+    // 处理完已发布的事件再退出订阅线程
+    events_.stop();
+    // 析构 OrderJournal 时同步落盘剩余的日志
+}
+
+template <typename Fn>
+void DomainService::withShard(Shard& shard, Fn&& fn)
+{
+    if (shard.worker) {
+        // 异常不能逃出工作线程，转交给调用线程重新抛出
+        std::exception_ptr error;
+        shard.worker->execute([&] {
+            try {
+                fn(shard.orders);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        });
+        if (error)
+            std::rethrow_exception(error);
+        return;
+    }
+    std::lock_guard<std::mutex> lk(shard.mtx);
+    fn(shard.orders);
+}
 
 common::OrderResult DomainService::processNewOrder(const common::Order& order)
 {
-    if (!validateNewOrder(order))
-        return { false, "", "", "Invalid order", order };
     common::Order o = order;
 
     // 为空的账户设置默认值
@@ -19,65 +133,169 @@ common::OrderResult DomainService::processNewOrder(const common::Order& order)
         o.account = "DEFAULT_ACCOUNT";
     }
 
+    auto risk = risk_.checkNew(o);
+    if (!risk.ok)
+        return { false, "", "", risk.reason, order };
+
     o.orderId = genOrderId();
     o.status = "NEW";
-    storeOrder(o);
-    if (order_cb_)
-        order_cb_(o, "NEW");
-    return { true, o.orderId, genExecId(), "Order accepted", o };
+    try {
+        storeOrder(o);
+    } catch (...) {
+        risk_.onOrderClosed(o);
+        throw;
+    }
+    risk_.onOrderAccepted(o);
+    common::OrderResult result { true, o.orderId, genExecId(), "Order accepted", o };
+    events_.publish({ o, result.execId, "0", "0" });
+    matchOrder(o, result.executions);
+    for (const auto& e : result.executions)
+        events_.publish(e);
+    return result;
 }
 
 common::OrderResult DomainService::processCancelOrder(const common::Order& order, const std::string& origClOrdId)
 {
-    auto ex = findOrderByClOrdId(origClOrdId);
-    if (!ex)
+    common::Order o;
+    switch (transitionOpen(order, origClOrdId, common::OrderState::Canceled, o)) {
+    case TransitionResult::NotFound:
         return { false, "", "", "Original order not found", order };
-    if (ex->status != "NEW")
+    case TransitionResult::NotOpen:
         return { false, "", "", "Order cannot be cancelled in current status", order };
-    updateOrderStatus(origClOrdId, "CANCELED");
-    common::Order o = *ex;
-    o.status = "CANCELED";
-    if (order_cb_)
-        order_cb_(o, "CANCELED");
-    return { true, o.orderId, genExecId(), "Order cancelled", o };
+    case TransitionResult::Ok:
+        break;
+    }
+    risk_.onOrderClosed(o);
+    common::OrderResult result { true, o.orderId, genExecId(), "Order cancelled", o };
+    events_.publish({ o, result.execId, "4", "4" });
+    return result;
 }
 
 common::OrderResult DomainService::processReplaceOrder(const common::Order& order, const std::string& origClOrdId)
 {
-    auto ex = findOrderByClOrdId(origClOrdId);
-    if (!ex)
+    // 改单请求不一定带账户、类型，按原订单补全后再做风控；原订单不存在时由下面的摘单给出拒绝原因
+    if (auto orig = findOrderByClOrdId(order.session, origClOrdId)) {
+        auto next = replacementOf(*orig, order);
+        auto risk = risk_.checkReplace(next);
+        if (!risk.ok)
+            return { false, "", "", risk.reason, order };
+        if (common::toFixed(next.quantity) <= common::toFixed(orig->cumQty))
+            return { false, "", "", "Replace quantity must exceed filled quantity", order };
+    }
+    common::Order o;
+    switch (transitionOpen(order, origClOrdId, common::OrderState::Replaced, o)) {
+    case TransitionResult::NotFound:
         return { false, "", "", "Original order not found", order };
-    if (ex->status != "NEW")
+    case TransitionResult::NotOpen:
         return { false, "", "", "Order cannot be modified in current status", order };
-    if (!validateReplaceOrder(order))
-        return { false, "", "", "Invalid replace request", order };
-    updateOrderStatus(origClOrdId, "REPLACED");
-    common::Order o = *ex;
-    o.status = "REPLACED";
-    if (order_cb_)
-        order_cb_(o, "REPLACED");
-    return { true, o.orderId, genExecId(), "Order replaced", o };
-}
-
-std::optional<common::Order> DomainService::findOrderByClOrdId(const std::string& clOrdId)
-{
-    std::lock_guard<std::mutex> lk(orders_mtx_);
-    auto it
-        = std::find_if(orders_.begin(), orders_.end(), [&](const common::Order& o) { return o.clOrdId == clOrdId; });
-    if (it == orders_.end())
-        return std::nullopt;
-    return *it;
+    case TransitionResult::Ok:
+        break;
+    }
+    // 查找与摘单之间原订单可能又有成交，以摘单时的副本为准；之后在途的成交仍记在原订单上
+    auto r = replacementOf(o, order);
+    r.orderId = genOrderId();
+    auto cum = common::toFixed(r.cumQty);
+    auto state = cum == 0                   ? common::OrderState::New
+        : cum < common::toFixed(r.quantity) ? common::OrderState::PartiallyFilled
+                                            : common::OrderState::Filled;
+    r.status = common::toString(state);
+    try {
+        storeOrder(r);
+    } catch (...) {
+        risk_.onOrderClosed(o);
+        margin_.onOrderClosed(o);
+        throw;
+    }
+    // 替换订单沿用原订单的挂单名额；敞口在此直接由原订单换成替换订单，不经事件总线
+    auto open = common::isOpen(state);
+    if (open)
+        risk_.onOrderAccepted(r);
+    else
+        risk_.onOrderClosed(r);
+    margin_.onOrderClosed(o);
+    if (open)
+        margin_.onOrderOpened(r);
+    common::OrderResult result { true, r.orderId, genExecId(), "Order replaced", r };
+    events_.publish({ r, result.execId, "5", ordStatusOf(state), 0.0, 0.0, {}, origClOrdId });
+    if (open)
+        matchOrder(r, result.executions);
+    for (const auto& e : result.executions)
+        events_.publish(e);
+    return result;
+}
+
+std::optional<common::Order> DomainService::findOrderByClOrdId(const std::string& session, const std::string& clOrdId)
+{
+    std::optional<common::Order> found;
+    for (auto& shard : shards_) {
+        withShard(*shard, [&](OrderStore& orders) {
+            auto h = orders.findByClOrdId(session, clOrdId);
+            found = h != kInvalidOrderHandle ? orders.get(h) : orders.findArchivedByClOrdId(session, clOrdId);
+        });
+        if (found)
+            break;
+    }
+    return found;
+}
+
+std::optional<common::Order> DomainService::findOrderByOrderId(const std::string& orderId)
+{
+    std::optional<common::Order> found;
+    for (auto& shard : shards_) {
+        withShard(*shard, [&](OrderStore& orders) {
+            auto h = orders.findByOrderId(orderId);
+            found = h != kInvalidOrderHandle ? orders.get(h) : orders.findArchivedByOrderId(orderId);
+        });
+        if (found)
+            break;
+    }
+    return found;
 }
 
 std::vector<common::Order> DomainService::getAllOrders()
 {
-    std::lock_guard<std::mutex> lk(orders_mtx_);
-    return orders_;
+    auto view = snapshot();
+    std::vector<common::Order> all;
+    all.reserve(view.size());
+    view.forEach({}, [&](const common::Order& o) { all.push_back(o); });
+    return all;
 }
 
-void DomainService::setOrderStatusCallback(std::function<void(const common::Order&, const std::string&)> cb)
+OrderStoreMetrics DomainService::getStoreMetrics()
 {
-    order_cb_ = std::move(cb);
+    OrderStoreMetrics total;
+    for (auto& shard : shards_)
+        withShard(*shard, [&](OrderStore& orders) { total += orders.metrics(); });
+    return total;
+}
+
+common::MarginUpdate DomainService::getMargin(const std::string& account) const { return margin_.marginOf(account); }
+
+OrderView DomainService::snapshot()
+{
+    std::vector<std::shared_ptr<const OrderSnapshot>> shards;
+    shards.reserve(shards_.size());
+    for (auto& shard : shards_) {
+        // 快照已是最新时直接复用；否则在分片上下文中发布，代价只是复制块指针
+        if (shard->orders.snapshotCurrent()) {
+            shards.push_back(shard->orders.latestSnapshot());
+            continue;
+        }
+        std::shared_ptr<const OrderSnapshot> snap;
+        withShard(*shard, [&](OrderStore& orders) { snap = orders.publish(); });
+        shards.push_back(std::move(snap));
+    }
+    return OrderView(std::move(shards));
+}
+
+void DomainService::subscribe(std::string name, std::function<void(const common::Execution&)> handler)
+{
+    events_.subscribe(std::move(name), std::move(handler));
+}
+
+void DomainService::publishReject(const common::Order& request, const std::string& reason)
+{
+    events_.publish({ request, {}, "8", "8", 0.0, 0.0, reason });
 }
 
 void DomainService::setMarginUpdateCallback(std::function<void(const common::MarginUpdate&)> cb)
@@ -87,92 +305,313 @@ void DomainService::setMarginUpdateCallback(std::function<void(const common::Mar
 
 void DomainService::startMarginUpdates()
 {
-    bool expected = false;
-    if (!margin_running_.compare_exchange_strong(expected, true))
+    std::lock_guard<std::mutex> lk(margin_timer_mtx_);
+    if (margin_running_)
         return;
-    margin_thread_ = std::thread([this] { marginLoop(); });
+    margin_timer_ = scheduler_->scheduleEvery(
+        std::chrono::seconds(config_.margin.publish_interval_s), [this] { publishMargins(); });
+    margin_running_ = true;
 }
 
 void DomainService::stopMarginUpdates()
 {
-    bool expected = true;
-    if (!margin_running_.compare_exchange_strong(expected, false))
+    std::lock_guard<std::mutex> lk(margin_timer_mtx_);
+    if (!margin_running_)
         return;
-    if (margin_thread_.joinable())
-        margin_thread_.join();
+    // 由 onLogout 调用时持有会话锁，而正在执行的推送可能正等待同一把锁发送，等待它会使两边都卡住
+    scheduler_->cancelNoWait(margin_timer_);
+    margin_running_ = false;
 }
 
-void DomainService::storeOrder(const common::Order& order)
+const std::string& DomainService::routingKey(const common::Order& order) const
 {
-    std::lock_guard<std::mutex> lk(orders_mtx_);
-    orders_.push_back(order);
+    return config_.shard_key == DomainConfig::ShardKey::Account ? order.account : order.symbol;
 }
 
-bool DomainService::updateOrderStatus(const std::string& clOrdId, const std::string& status)
+std::size_t DomainService::shardIndex(std::string_view key) const
 {
-    std::lock_guard<std::mutex> lk(orders_mtx_);
-    auto it
-        = std::find_if(orders_.begin(), orders_.end(), [&](const common::Order& o) { return o.clOrdId == clOrdId; });
-    if (it == orders_.end())
-        return false;
-    it->status = status;
-    return true;
+    if (shards_.size() == 1)
+        return 0;
+    return std::hash<std::string_view> {}(key) % shards_.size();
 }
 
-bool DomainService::validateNewOrder(const common::Order& order) const
+DomainService::Shard& DomainService::shardFor(std::string_view key) { return *shards_[shardIndex(key)]; }
+
+common::Order DomainService::replacementOf(const common::Order& orig, const common::Order& request)
+{
+    common::Order r = orig;
+    r.orderId.clear();
+    r.clOrdId = request.clOrdId;
+    if (request.quantity > 0)
+        r.quantity = request.quantity;
+    if (request.price > 0)
+        r.price = request.price;
+    return r;
+}
+
+void DomainService::storeOrder(const common::Order& order)
 {
-    // 检查数量
-    if (order.quantity <= 0) {
-        SPDLOG_WARN("Order validation failed: invalid quantity {}", order.quantity);
-        return false;
+    auto& shard = shardFor(routingKey(order));
+    withShard(shard, [&](OrderStore& orders) {
+        auto record = OrderRecordView::of(order);
+        // 先写日志再更新内存
+        if (shard.journal)
+            shard.journal->appendInsert(record);
+        orders.insert(record);
+    });
+}
+
+DomainService::TransitionResult DomainService::transitionOpen(
+    const common::Order& request, const std::string& clOrdId, common::OrderState state, common::Order& out)
+{
+    const auto& key = routingKey(request);
+    if (!key.empty() || shards_.size() == 1)
+        return transitionOnShard(shardFor(key), request.session, clOrdId, state, out);
+    for (auto& shard : shards_) {
+        auto r = transitionOnShard(*shard, request.session, clOrdId, state, out);
+        if (r != TransitionResult::NotFound)
+            return r;
     }
+    return TransitionResult::NotFound;
+}
+
+DomainService::TransitionResult DomainService::transitionOnShard(Shard& shard, const std::string& session,
+    const std::string& clOrdId, common::OrderState state, common::Order& out)
+{
+    auto result = TransitionResult::Ok;
+    withShard(shard, [&](OrderStore& orders) {
+        // 其他会话的同名 ClOrdID 查不到，按未找到拒绝
+        auto h = orders.findByClOrdId(session, clOrdId);
+        if (h == kInvalidOrderHandle) {
+            // 已淘汰到冷存储的订单必然处于终态
+            result = orders.findArchivedByClOrdId(session, clOrdId) ? TransitionResult::NotOpen
+                                                                    : TransitionResult::NotFound;
+            return;
+        }
+        if (!common::isOpen(orders.state(h))) {
+            result = TransitionResult::NotOpen;
+            return;
+        }
+        // 先取副本：进入终态后订单可能立即被淘汰，句柄随之失效
+        out = orders.get(h);
+        // 先从订单簿摘除；已不在簿中说明已全部成交、成交回报还在途中，不能再撤/改
+        if (restsInBook(out.orderType, out.timeInForce) && !matching_.cancel(out.symbol, bookId(out.orderId))) {
+            result = TransitionResult::NotOpen;
+            return;
+        }
+        out.status = common::toString(state);
+        updateOrderStatus(shard, orders, h, state);
+    });
+    return result;
+}
+
+void DomainService::updateOrderStatus(Shard& shard, OrderStore& orders, OrderHandle handle, common::OrderState state)
+{
+    if (shard.journal)
+        shard.journal->appendState(orders.orderId(handle), state);
+    orders.setState(handle, state);
+}
 
-    // 检查价格（非市价单需要价格）
-    if (order.orderType != '1' && order.price <= 0) {
-        SPDLOG_WARN("Order validation failed: non-market order requires price");
-        return false;
+void DomainService::matchOrder(const common::Order& order, std::vector<common::Execution>& out)
+{
+    auto request = bookRequest(order);
+    auto rest = restsInBook(order.orderType, order.timeInForce);
+    std::vector<BookFill> fills;
+    auto leaves = matching_.submit(order.symbol, request, rest, fills);
+    for (const auto& fill : fills) {
+        // 每笔成交先回报主动方，再回报被动方
+        if (auto e = applyFill(request.owner, order.orderId, fill.quantity, fill.price))
+            out.push_back(std::move(*e));
+        if (auto e = applyFill(fill.maker_owner, std::string(IdGenerator::encode(fill.maker_id)), fill.quantity,
+                fill.price))
+            out.push_back(std::move(*e));
+    }
+    // 市价单与 IOC/FOK 不挂单，未成交部分立即撤销
+    if (leaves > 0 && !rest) {
+        if (auto e = cancelRemainder(request.owner, order.orderId))
+            out.push_back(std::move(*e));
     }
+}
 
-    // 检查符号
-    if (order.symbol.empty()) {
-        SPDLOG_WARN("Order validation failed: empty symbol");
-        return false;
+std::optional<common::Execution> DomainService::applyFill(
+    std::size_t index, const std::string& orderId, std::int64_t quantity, std::int64_t price)
+{
+    auto& shard = *shards_[index];
+    std::optional<common::Order> before;
+    common::Order after;
+    auto state = common::OrderState::New;
+    withShard(shard, [&](OrderStore& orders) {
+        auto h = orders.findByOrderId(orderId);
+        if (h == kInvalidOrderHandle)
+            return;
+        auto v = orders.view(h);
+        auto cum = v.cum_qty + quantity;
+        // 均价按成交金额加权，仍以定点数存放
+        auto avg = static_cast<std::int64_t>(std::llround(
+            (static_cast<double>(v.avg_px) * v.cum_qty + static_cast<double>(price) * quantity) / cum));
+        // 成交回报在途时订单可能已被撤销：保持终态，只累计成交量
+        state = !common::isOpen(v.state) ? v.state
+            : cum >= v.quantity          ? common::OrderState::Filled
+                                         : common::OrderState::PartiallyFilled;
+        // 先取副本：全部成交后订单可能立即被淘汰，句柄随之失效
+        before = orders.get(h);
+        if (shard.journal)
+            shard.journal->appendFill(v.order_id, state, cum, avg);
+        orders.setFill(h, cum, avg, state);
+        after = *before;
+        after.cumQty = common::fromFixed(cum);
+        after.avgPx = common::fromFixed(avg);
+        after.status = common::toString(state);
+    });
+    if (!before) {
+        SPDLOG_WARN("Fill for unknown order: OrderID={}", orderId);
+        return std::nullopt;
     }
+    if (common::isOpen(common::parseOrderState(before->status)) && state == common::OrderState::Filled)
+        risk_.onOrderClosed(after);
+    return common::Execution { std::move(after), genExecId(), "F", ordStatusOf(state), common::fromFixed(quantity),
+        common::fromFixed(price) };
+}
 
-    // 账户可以为空，使用默认值
-    // 放宽账户验证，允许空账户
-    return true;
+std::optional<common::Execution> DomainService::cancelRemainder(std::size_t index, const std::string& orderId)
+{
+    auto& shard = *shards_[index];
+    std::optional<common::Order> canceled;
+    withShard(shard, [&](OrderStore& orders) {
+        auto h = orders.findByOrderId(orderId);
+        if (h == kInvalidOrderHandle || !common::isOpen(orders.state(h)))
+            return;
+        canceled = orders.get(h);
+        canceled->status = common::toString(common::OrderState::Canceled);
+        updateOrderStatus(shard, orders, h, common::OrderState::Canceled);
+    });
+    if (!canceled)
+        return std::nullopt;
+    risk_.onOrderClosed(*canceled);
+    return common::Execution { std::move(*canceled), genExecId(), "4", "4" };
 }
 
-bool DomainService::validateReplaceOrder(const common::Order& order) const
+bool DomainService::restsInBook(char orderType, char timeInForce)
 {
-    if (order.quantity <= 0)
-        return false;
-    if (order.orderType != '1' && order.price <= 0)
-        return false;
-    return true;
+    // 限价单挂单；市价单与 IOC(3)/FOK(4) 只撮合不挂单
+    return orderType == '2' && timeInForce != '3' && timeInForce != '4';
 }
 
-std::string DomainService::genOrderId() { return std::to_string(order_seq_++); }
-std::string DomainService::genExecId() { return std::to_string(exec_seq_++); }
+std::uint64_t DomainService::bookId(std::string_view orderId)
+{
+    // OrderID 均由 IdGenerator 生成，订单簿中的 id 与之一一对应，成交时再由 id 编码回 OrderID
+    return IdGenerator::decode(orderId).value_or(0);
+}
 
-void DomainService::marginLoop()
+BookOrderRequest DomainService::bookRequest(const common::Order& order) const
 {
-    double margin = 100000.0;
-    while (margin_running_) {
-        for (int i = 0; i < 300 && margin_running_; ++i) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BookOrderRequest request;
+    request.id = bookId(order.orderId);
+    request.owner = static_cast<std::uint32_t>(shardIndex(routingKey(order)));
+    request.side = order.side;
+    request.market = order.orderType == '1';
+    request.price = common::toFixed(order.price);
+    // 恢复的订单只挂剩余数量
+    request.quantity = common::toFixed(order.quantity) - common::toFixed(order.cumQty);
+    return request;
+}
+
+std::string DomainService::genOrderId() { return std::string(IdGenerator::nextText()); }
+std::string DomainService::genExecId() { return std::string(IdGenerator::nextText()); }
+
+void DomainService::applyMarginEvent(const common::Execution& e)
+{
+    // 各事件对敞口的增减可以交换，不同发布线程的事件交错到达不影响结果
+    switch (e.execType[0]) {
+    case '0':
+        margin_.onOrderOpened(e.order);
+        break;
+    case '4':
+        margin_.onOrderClosed(e.order);
+        break;
+    case 'F':
+        // 撤单后才到达的成交（OrdStatus 4）不再影响敞口：撤单时已整体释放
+        if (e.ordStatus == "1" || e.ordStatus == "2") {
+            auto before = e.order;
+            before.cumQty = common::fromFixed(common::toFixed(e.order.cumQty) - common::toFixed(e.lastQty));
+            margin_.onOrderFilled(before, e.order);
         }
-        if (!margin_running_)
-            break;
-        if (margin_cb_) {
-            common::MarginUpdate mu;
-            mu.account = "ACC-001";
-            mu.marginValue = margin;
-            mu.marginLevel = 30.0;
-            mu.marginExcess = margin * 0.7;
-            mu.currency = "USD";
+        break;
+    default:
+        // 改单（5）的敞口已在 processReplaceOrder 中直接调整
+        break;
+    }
+}
+
+void DomainService::publishMargins()
+{
+    // 只推送有变化的账户
+    auto updates = margin_.drainChanged();
+    if (margin_cb_) {
+        for (const auto& mu : updates)
             margin_cb_(mu);
+    }
+}
+
+void DomainService::recoverJournals()
+{
+    // 每个分片的日志回放到同编号的分片，而请求按 hash(路由键) % 分片数 路由：
+    // 分片数或路由键一变，恢复出的订单就落在请求路由不到的分片上，因此两者都不得改变
+    auto layout = "shard_count=" + std::to_string(shards_.size());
+    if (shards_.size() > 1)
+        layout += config_.shard_key == DomainConfig::ShardKey::Account ? " shard_key=account" : " shard_key=symbol";
+    auto recorded = OrderJournal::readLayout(config_.journal.dir);
+    if (recorded.empty()) {
+        // 记录布局之前写的日志只能确认分片数
+        auto existing = OrderJournal::shardCount(config_.journal.dir);
+        if (existing != 0 && existing != shards_.size())
+            recorded = "shard_count=" + std::to_string(existing);
+    }
+    if (!recorded.empty() && recorded != layout)
+        throw std::runtime_error("journal in " + config_.journal.dir + " was written with " + recorded
+            + ", domain config has " + layout + "; restore the original shard_count/shard_key or move the journal");
+    OrderJournal::writeLayout(config_.journal.dir, layout);
+
+    for (std::size_t i = 0; i < shards_.size(); ++i) {
+        auto& shard = *shards_[i];
+        auto& orders = shard.orders;
+        auto stats = shard.journal->recover([&](const OrderRecordView& o) { orders.insert(o); },
+            [&](std::string_view orderId, common::OrderState state) {
+                auto h = orders.findByOrderId(orderId);
+                if (h != kInvalidOrderHandle)
+                    orders.setState(h, state);
+            },
+            [&](std::string_view orderId, common::OrderState state, std::int64_t cum_qty, std::int64_t avg_px) {
+                auto h = orders.findByOrderId(orderId);
+                if (h != kInvalidOrderHandle)
+                    orders.setFill(h, cum_qty, avg_px, state);
+            });
+        shard.journal->open();
+        SPDLOG_INFO("Journal recovered shard {}: snapshot orders={}, replayed inserts={}, replayed states={}, seq={}",
+            i, stats.snapshot_orders, stats.replayed_inserts, stats.replayed_states, stats.position.seq);
+    }
+}
+
+void DomainService::flushJournals()
+{
+    for (auto& shard : shards_)
+        shard->journal->flush();
+}
+
+void DomainService::snapshotJournals()
+{
+    for (auto& shard : shards_) {
+        // 发布快照与切换日志段在同一个分片上下文中完成，快照恰好覆盖到返回的日志位置
+        std::shared_ptr<const OrderSnapshot> snap;
+        JournalPosition position;
+        withShard(*shard, [&](OrderStore& orders) {
+            snap = orders.publish();
+            position = shard->journal->rollForSnapshot();
+        });
+        try {
+            shard->journal->writeSnapshot(*snap, position);
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("Journal snapshot failed: {}", e.what());
         }
     }
 }
@@ -1,50 +1,121 @@
 #pragma once
 
+#include "app_config.h"
 #include "common_types.h"
+#include "event_bus.h"
+#include "margin_engine.h"
+#include "matching_engine.h"
+#include "order_journal.h"
+#include "order_store.h"
+#include "risk_engine.h"
+#include "shard_worker.h"
+#include "timer_scheduler.h"
 
-#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <thread>
+#include <string_view>
 #include <vector>
 
 class DomainService {
 public:
-    DomainService();
+    // 周期任务（保证金推送、日志落盘与快照）交给共享的定时器执行，不再各自占用线程
+    explicit DomainService(
+        const DomainConfig& config = {}, std::shared_ptr<TimerScheduler> scheduler = TimerScheduler::shared());
     ~DomainService();
 
+    // 新订单在存储后立即进入该品种的订单簿撮合；确认与成交回报依次发布到事件总线，
+    // 成交回报同时放在 OrderResult::executions 中
     common::OrderResult processNewOrder(const common::Order& order);
+    // 原订单按 (order.session, OrigClOrdID) 查找：只能撤/改本会话下的订单
     common::OrderResult processCancelOrder(const common::Order& order, const std::string& origClOrdId);
+    // 改单：原订单进入 REPLACED 并从订单簿摘除，以新 OrderID、请求的 ClOrdID 生成替换订单，存储后重新撮合
     common::OrderResult processReplaceOrder(const common::Order& order, const std::string& origClOrdId);
 
-    std::optional<common::Order> findOrderByClOrdId(const std::string& clOrdId);
+    std::optional<common::Order> findOrderByClOrdId(const std::string& session, const std::string& clOrdId);
+    std::optional<common::Order> findOrderByOrderId(const std::string& orderId);
     std::vector<common::Order> getAllOrders();
+    // 所有分片的只读快照视图；读者遍历/分页时不持有任何锁，不阻塞下单
+    OrderView snapshot();
+    // 热/冷存储规模与淘汰计数（各分片汇总）
+    OrderStoreMetrics getStoreMetrics();
+    // 账户当前的保证金（由订单事件增量维护）
+    common::MarginUpdate getMargin(const std::string& account) const;
 
-    void setOrderStatusCallback(std::function<void(const common::Order&, const std::string&)> cb);
+    // 订阅订单事件（确认、撤单、改单、成交）：事件在订阅者自己的线程上按发布顺序投递，下单路径不等待处理
+    void subscribe(std::string name, std::function<void(const common::Execution&)> handler);
+    // 请求被拒绝（ExecType 8）：与回报一起经事件总线发布，不会越过同一线程之前发布的回报
+    void publishReject(const common::Order& request, const std::string& reason);
     void setMarginUpdateCallback(std::function<void(const common::MarginUpdate&)> cb);
 
     void startMarginUpdates();
+    // 不等待正在执行的推送，可在 QuickFIX 回调内（持有会话锁）调用
     void stopMarginUpdates();
 
 private:
+    // 分片：单分片时由 mtx 保护（内联模式），多分片时由 worker 线程独占写入
+    struct Shard {
+        OrderStore orders;
+        std::mutex mtx;
+        std::unique_ptr<ShardWorker> worker;
+        std::unique_ptr<OrderJournal> journal; // 未开启日志时为空
+    };
+
+    enum class TransitionResult { Ok, NotFound, NotOpen };
+
+    // 在分片上下文中执行 fn(OrderStore&)
+    template <typename Fn>
+    void withShard(Shard& shard, Fn&& fn);
+    const std::string& routingKey(const common::Order& order) const;
+    std::size_t shardIndex(std::string_view key) const;
+    Shard& shardFor(std::string_view key);
+
     void storeOrder(const common::Order& order);
-    bool updateOrderStatus(const std::string& clOrdId, const std::string& status);
-    bool validateNewOrder(const common::Order& order) const;
-    bool validateReplaceOrder(const common::Order& order) const;
+    // 替换订单：数量、价格取自改单请求（未带则沿用原订单），其余字段与已成交部分沿用原订单；不含 OrderID
+    static common::Order replacementOf(const common::Order& orig, const common::Order& request);
+    // 按请求中的路由键定位分片；请求缺少路由键时依次探查所有分片
+    TransitionResult transitionOpen(
+        const common::Order& request, const std::string& clOrdId, common::OrderState state, common::Order& out);
+    // 在同一个分片上下文内完成查找、挂单状态校验、从订单簿摘除与原地更新，成功时 out 为更新后的订单副本
+    TransitionResult transitionOnShard(Shard& shard, const std::string& session, const std::string& clOrdId,
+        common::OrderState state, common::Order& out);
+    // 调用方需处于该分片的上下文中
+    void updateOrderStatus(Shard& shard, OrderStore& orders, OrderHandle handle, common::OrderState state);
+    // 撮合新订单，并把主动方/被动方的成交、未成交部分的撤销依次更新到各自分片
+    void matchOrder(const common::Order& order, std::vector<common::Execution>& out);
+    std::optional<common::Execution> applyFill(
+        std::size_t shard, const std::string& orderId, std::int64_t quantity, std::int64_t price);
+    std::optional<common::Execution> cancelRemainder(std::size_t shard, const std::string& orderId);
+    static bool restsInBook(char orderType, char timeInForce);
+    static std::uint64_t bookId(std::string_view orderId);
+    BookOrderRequest bookRequest(const common::Order& order) const;
+    void applyMarginEvent(const common::Execution& e);
     std::string genOrderId();
     std::string genExecId();
-    void marginLoop();
+    void publishMargins();
+    // 启动时（工作线程启动前）由快照 + 日志尾部恢复各分片，并续接 OrderID/ExecID
+    void recoverJournals();
+    void flushJournals();
+    void snapshotJournals();
 
 private:
-    std::vector<common::Order> orders_;
-    std::mutex orders_mtx_;
+    DomainConfig config_;
+    std::vector<std::unique_ptr<Shard>> shards_;
 
-    std::function<void(const common::Order&, const std::string&)> order_cb_;
     std::function<void(const common::MarginUpdate&)> margin_cb_;
+    MarginEngine margin_;
+    RiskEngine risk_;
+    MatchingEngine matching_;
 
-    std::atomic<bool> margin_running_ { false };
-    std::thread margin_thread_;
-    std::atomic<unsigned long long> order_seq_ { 1 };
-    std::atomic<unsigned long long> exec_seq_ { 1 };
+    std::shared_ptr<TimerScheduler> scheduler_;
+    std::mutex margin_timer_mtx_;
+    // 停止推送后仍保留最后一个定时器，析构时等待它可能仍在执行的回调
+    TimerId margin_timer_ { kInvalidTimerId };
+    bool margin_running_ { false };
+    TimerId journal_flush_timer_ { kInvalidTimerId };
+    TimerId journal_snapshot_timer_ { kInvalidTimerId };
+    // 订阅者会访问上面的成员，放在最后以便最先析构
+    EventBus<common::Execution> events_;
 };
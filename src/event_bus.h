@@ -0,0 +1,102 @@
+#pragma once
+
+#include "app_config.h"
+#include "queue_worker.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 类型化的事件总线：每个订阅者一个 QueueWorker（MPSC 环形队列 + 消费线程），
+// 发布方只把事件复制进各订阅者的队列，不等待处理，也不做消息构造或网络 I/O。
+// 同一发布线程发布的事件对每个订阅者保持顺序；队列满时按配置阻塞等待（block）或丢弃并计数（drop），
+// 声明为 lossless 的订阅者总是阻塞等待。
+// 线程安全。
+template <typename T>
+class EventBus {
+public:
+    using Handler = std::function<void(const T&)>;
+    static constexpr std::size_t kMaxSubscribers = 8;
+
+    explicit EventBus(const EventBusConfig& config = {})
+        : config_(config)
+    {
+    }
+    ~EventBus() { stop(); }
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    // 注册订阅者并启动它的消费线程；之前发布的事件不会投递给它。
+    // lossless 的订阅者（由事件增量维护状态，丢一条就再也对不上）队列满时总是阻塞等待，不受 back_pressure 影响
+    void subscribe(std::string name, Handler handler, bool lossless = false)
+    {
+        std::lock_guard<std::mutex> lk(subscribe_mtx_);
+        auto count = count_.load(std::memory_order_relaxed);
+        if (count == kMaxSubscribers)
+            throw std::length_error("EventBus: too many subscribers");
+        subscribers_[count] = std::make_unique<QueueWorker<T>>(
+            std::move(name), config_.capacity, [h = std::move(handler)](T& event) { h(event); });
+        droppable_[count] = !lossless && config_.back_pressure == EventBusConfig::BackPressure::Drop;
+        count_.store(count + 1, std::memory_order_release);
+    }
+
+    void publish(const T& event)
+    {
+        auto count = count_.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (droppable_[i])
+                subscribers_[i]->offer(event);
+            else
+                subscribers_[i]->push(event);
+        }
+    }
+
+    // 处理完已入队的事件后停止所有消费线程
+    void stop()
+    {
+        std::lock_guard<std::mutex> lk(subscribe_mtx_);
+        if (stopped_)
+            return;
+        stopped_ = true;
+        auto count = count_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < count; ++i) {
+            subscribers_[i]->stop();
+            if (auto dropped = subscribers_[i]->metrics().dropped)
+                SPDLOG_WARN("EventBus subscriber {} dropped {} events", subscribers_[i]->name(), dropped);
+        }
+    }
+
+    // 因队列满被丢弃的事件数（所有订阅者合计）
+    std::uint64_t dropped() const
+    {
+        std::uint64_t total = 0;
+        for (const auto& m : metrics())
+            total += m.dropped;
+        return total;
+    }
+
+    std::vector<QueueMetrics> metrics() const
+    {
+        std::vector<QueueMetrics> all;
+        auto count = count_.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i)
+            all.push_back(subscribers_[i]->metrics());
+        return all;
+    }
+
+private:
+    EventBusConfig config_;
+    std::mutex subscribe_mtx_;
+    bool stopped_ { false };
+    std::array<std::unique_ptr<QueueWorker<T>>, kMaxSubscribers> subscribers_;
+    std::array<bool, kMaxSubscribers> droppable_ {};
+    std::atomic<std::size_t> count_ { 0 };
+};
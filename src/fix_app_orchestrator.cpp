@@ -2,58 +2,174 @@
 
 #include <spdlog/spdlog.h>
 
-FixAppOrchestrator::FixAppOrchestrator(std::unique_ptr<DomainService> svc, std::unique_ptr<FixSender> fix_sender)
+#include "timer_scheduler.h"
+
+#include <chrono>
+
+namespace {
+
+// UTC 纪元日，ClOrdID 去重按天重置
+std::int64_t utcDay()
+{
+    return std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now()).time_since_epoch().count();
+}
+
+} // namespace
+
+FixAppOrchestrator::FixAppOrchestrator(
+    std::unique_ptr<DomainService> svc, std::unique_ptr<FixSender> fix_sender, const ServerConfig& config)
     : svc_(std::move(svc))
     , fix_sender_(std::move(fix_sender))
+    , config_(config)
+    , traffic_(config.traffic_log)
 {
-    svc_->setOrderStatusCallback([this](const common::Order& o, const std::string& st) {
-        auto sid = getSessionId();
-        if (!sid)
-            return;
-        sendExecutionReport(o, "EXEC_STATUS", "8", st, *sid); // ExecType '8' just as placeholder for status update
-    });
+    // 执行回报在事件总线的订阅线程上构造与发送，不占用 QuickFIX 的收消息线程
+    svc_->subscribe("fix-reporter", [this](const common::Execution& e) { report(e); });
     svc_->setMarginUpdateCallback([this](const common::MarginUpdate& mu) { sendMargin(mu); });
+    if (config_.pipeline)
+        startPipeline();
+}
+
+FixAppOrchestrator::~FixAppOrchestrator()
+{
+    stopPipeline();
+    // 先停掉领域服务（及其事件订阅线程），订阅线程还会用到 fix_sender_
+    svc_.reset();
 }
 
 void FixAppOrchestrator::onCreate(const FIX::SessionID& sessionID)
 {
     SPDLOG_INFO("onCreate: {}", sessionID.toString());
+    sessions_.add(sessionID);
 }
 
 void FixAppOrchestrator::onLogon(const FIX::SessionID& sessionID)
 {
     SPDLOG_INFO("onLogon: {}", sessionID.toString());
-    setSessionId(sessionID);
-    svc_->startMarginUpdates();
+    if (sessions_.add(sessionID).setLoggedOn(true))
+        return;
+    // 第一个会话登录时开始推送保证金
+    if (logged_on_.fetch_add(1) == 0)
+        svc_->startMarginUpdates();
 }
 
 void FixAppOrchestrator::onLogout(const FIX::SessionID& sessionID)
 {
     SPDLOG_INFO("onLogout: {}", sessionID.toString());
-    svc_->stopMarginUpdates();
-    clearSessionId();
+    auto* session = sessions_.find(sessionID);
+    if (!session || !session->setLoggedOn(false))
+        return;
+    if (logged_on_.fetch_sub(1) == 1)
+        svc_->stopMarginUpdates();
 }
 
 void FixAppOrchestrator::toAdmin(FIX::Message& message, const FIX::SessionID& sessionID)
 {
-    SPDLOG_DEBUG("toAdmin: {}", message.toString());
+    traffic_.message(TrafficFormat::ToAdmin, message);
 }
 
 void FixAppOrchestrator::fromAdmin(const FIX::Message& message, const FIX::SessionID& sessionID)
 {
-    SPDLOG_DEBUG("fromAdmin: {}", message.toString());
+    traffic_.message(TrafficFormat::FromAdmin, message);
 }
 
 void FixAppOrchestrator::toApp(FIX::Message& message, const FIX::SessionID& sessionID)
 {
-    SPDLOG_INFO("toApp:   {}", message.toString());
+    traffic_.message(TrafficFormat::ToApp, message);
 }
 
 void FixAppOrchestrator::onFromApp(const FIX::Message& message, const FIX::SessionID& sessionID)
+{
+    traffic_.message(TrafficFormat::FromApp, message);
+    if (decode_) {
+        // 流水线模式下 socket 线程只把报文序列化成一个字符串入队，解码级直接扫描原始报文，不再复制 FIX::Message
+        InboundMessage item { {}, sessionID };
+        message.toString(item.raw);
+        decode_->push(std::move(item));
+    } else {
+        decode(message, sessionID);
+    }
+}
+
+void FixAppOrchestrator::onMessage(const FIX44::NewOrderSingle& nos, const FIX::SessionID& sessionID)
+{
+    InboundRequest request { InboundRequest::Kind::NewOrder, {}, {}, sessionID };
+    if (auto error = FixMessageConverter::parseNewOrderSingle(nos, request.order))
+        rejectMalformed(request, error);
+    else
+        dispatch(request);
+}
+
+void FixAppOrchestrator::onMessage(const FIX44::OrderCancelRequest& ocr, const FIX::SessionID& sessionID)
+{
+    InboundRequest request { InboundRequest::Kind::Cancel, {}, {}, sessionID };
+    if (auto error = FixMessageConverter::parseCancelRequest(ocr, request.order, request.origClOrdId))
+        rejectMalformed(request, error);
+    else
+        dispatch(request);
+}
+
+void FixAppOrchestrator::onMessage(const FIX44::OrderCancelReplaceRequest& ocrr, const FIX::SessionID& sessionID)
+{
+    InboundRequest request { InboundRequest::Kind::Replace, {}, {}, sessionID };
+    if (auto error = FixMessageConverter::parseReplaceRequest(ocrr, request.order, request.origClOrdId))
+        rejectMalformed(request, error);
+    else
+        dispatch(request);
+}
+
+std::vector<QueueMetrics> FixAppOrchestrator::pipelineMetrics() const
+{
+    if (!decode_)
+        return {};
+    return { decode_->metrics(), domain_->metrics() };
+}
+
+void FixAppOrchestrator::startPipeline()
+{
+    // 两级各一个线程、首尾相连，整体先进先出，同一会话的消息顺序不变
+    domain_ = std::make_unique<QueueWorker<InboundRequest>>(
+        "domain", config_.pipeline_queue, [this](InboundRequest& r) { apply(r); });
+    decode_ = std::make_unique<QueueWorker<InboundMessage>>(
+        "decode", config_.pipeline_queue, [this](InboundMessage& m) { decode(m); });
+    if (config_.pipeline_metrics_interval_s > 0) {
+        metrics_timer_ = TimerScheduler::shared()->scheduleEvery(
+            std::chrono::seconds(config_.pipeline_metrics_interval_s), [this] {
+                for (const auto& m : pipelineMetrics()) {
+                    SPDLOG_INFO("Pipeline stage {}: depth={}, processed={}, wait avg/max={:.1f}/{:.1f}us, "
+                                "service avg/max={:.1f}/{:.1f}us",
+                        m.name, m.depth, m.processed, m.avg_wait_us, m.max_wait_us, m.avg_service_us,
+                        m.max_service_us);
+                }
+            });
+    }
+}
+
+void FixAppOrchestrator::stopPipeline()
+{
+    TimerScheduler::shared()->cancel(metrics_timer_);
+    // 按数据流向依次排空
+    if (decode_)
+        decode_->stop();
+    if (domain_)
+        domain_->stop();
+}
+
+void FixAppOrchestrator::decode(const FIX::Message& message, const FIX::SessionID& sessionID)
 {
     try {
-        SPDLOG_INFO("fromApp: {}", message.toString());
-        crack(message, sessionID);
+        // 按 MsgType 直接分派（与 MessageCracker 相同的静态转换），不支持的类型只记日志，不抛 UnsupportedMessageType
+        const auto* msgType = fixfield::find(message.getHeader(), FIX::FIELD::MsgType);
+        if (!msgType)
+            SPDLOG_WARN("fromApp: message without MsgType");
+        else if (*msgType == FIX::MsgType_NewOrderSingle)
+            onMessage(static_cast<const FIX44::NewOrderSingle&>(message), sessionID);
+        else if (*msgType == FIX::MsgType_OrderCancelRequest)
+            onMessage(static_cast<const FIX44::OrderCancelRequest&>(message), sessionID);
+        else if (*msgType == FIX::MsgType_OrderCancelReplaceRequest)
+            onMessage(static_cast<const FIX44::OrderCancelReplaceRequest&>(message), sessionID);
+        else
+            SPDLOG_WARN("fromApp: unsupported MsgType {}", *msgType);
     } catch (const std::exception& ex) {
         SPDLOG_ERROR("fromApp error: {}", ex.what());
     } catch (...) {
@@ -61,128 +177,186 @@ void FixAppOrchestrator::onFromApp(const FIX::Message& message, const FIX::Sessi
     }
 }
 
-void FixAppOrchestrator::onMessage(const FIX44::NewOrderSingle& nos, const FIX::SessionID& sessionID)
+void FixAppOrchestrator::decode(InboundMessage& message)
 {
-    try {
-        auto order = FixMessageConverter::parseNewOrderSingle(nos);
-        SPDLOG_INFO("Processing NewOrderSingle: ClOrdID={}, Symbol={}, Qty={}, Price={}", order.clOrdId, order.symbol,
-            order.quantity, order.price);
-
-        auto r = svc_->processNewOrder(order);
-        if (r.success) {
-            SPDLOG_INFO("Order accepted: ClOrdID={}, OrderID={}", order.clOrdId, r.orderId);
-            sendExecutionReport(r.updatedOrder, r.execId, "0", "0", sessionID); // NEW/NEW
-        } else {
-            SPDLOG_WARN("Order rejected: ClOrdID={}, Reason={}", order.clOrdId, r.message);
-            sendOrderReject(order.clOrdId, r.message, sessionID);
-        }
-    } catch (const std::exception& ex) {
-        SPDLOG_ERROR("NOS error: {}", ex.what());
-        // 发送拒绝消息
-        try {
-            FIX::ClOrdID clOrdId;
-            nos.get(clOrdId);
-            sendOrderReject(clOrdId.getValue(), "Internal error processing order", sessionID);
-        } catch (...) {
-            SPDLOG_ERROR("Failed to send rejection message");
-        }
+    InboundOrderView view;
+    auto error = FixOrderParser::parse(message.raw, view);
+    InboundRequest request { InboundRequest::Kind::NewOrder, {}, {}, message.sessionID };
+    if (view.msgType == FIX::MsgType_NewOrderSingle) {
+        request.kind = InboundRequest::Kind::NewOrder;
+    } else if (view.msgType == FIX::MsgType_OrderCancelRequest) {
+        request.kind = InboundRequest::Kind::Cancel;
+    } else if (view.msgType == FIX::MsgType_OrderCancelReplaceRequest) {
+        request.kind = InboundRequest::Kind::Replace;
+    } else {
+        SPDLOG_WARN("fromApp: unsupported MsgType {}", view.msgType);
+        return;
     }
+    FixMessageConverter::toOrder(view, request.order, request.origClOrdId);
+    request.error = error;
+    dispatch(request);
 }
 
-void FixAppOrchestrator::onMessage(const FIX44::OrderCancelRequest& ocr, const FIX::SessionID& sessionID)
+void FixAppOrchestrator::dispatch(InboundRequest& request)
 {
+    if (domain_)
+        domain_->push(request);
+    else
+        apply(request);
+}
+
+void FixAppOrchestrator::apply(InboundRequest& request)
+{
+    const auto& order = request.order;
+    if (request.error) {
+        rejectMalformed(request, request.error);
+        return;
+    }
     try {
-        std::string orig;
-        auto order = FixMessageConverter::parseCancelRequest(ocr, orig);
-        SPDLOG_INFO("Processing OrderCancelRequest: ClOrdID={}, OrigClOrdID={}", order.clOrdId, orig);
-
-        auto r = svc_->processCancelOrder(order, orig);
-        if (r.success) {
-            SPDLOG_INFO("Cancel order accepted: ClOrdID={}, OrderID={}", order.clOrdId, r.orderId);
-            sendExecutionReport(r.updatedOrder, r.execId, "4", "4", sessionID); // CANCELED
-        } else {
-            SPDLOG_WARN("Cancel order rejected: ClOrdID={}, Reason={}", order.clOrdId, r.message);
-            sendOrderReject(order.clOrdId, r.message, sessionID);
+        switch (request.kind) {
+        case InboundRequest::Kind::NewOrder:
+            applyNewOrder(request);
+            break;
+        case InboundRequest::Kind::Cancel:
+            applyCancel(request);
+            break;
+        case InboundRequest::Kind::Replace:
+            applyReplace(request);
+            break;
         }
     } catch (const std::exception& ex) {
-        SPDLOG_ERROR("CxlReq error: {}", ex.what());
-        // 发送拒绝消息
-        try {
-            FIX::ClOrdID clOrdId;
-            ocr.get(clOrdId);
-            sendOrderReject(clOrdId.getValue(), "Internal error processing cancel request", sessionID);
-        } catch (...) {
-            SPDLOG_ERROR("Failed to send cancel rejection message");
-        }
+        SPDLOG_ERROR("Request error: ClOrdID={}, {}", order.clOrdId, ex.what());
+        static const char* const kReasons[] = { "Internal error processing order",
+            "Internal error processing cancel request", "Internal error processing replace request" };
+        reject(order.clOrdId, kReasons[static_cast<int>(request.kind)], request.sessionID);
     }
 }
 
-void FixAppOrchestrator::onMessage(const FIX44::OrderCancelReplaceRequest& ocrr, const FIX::SessionID& sessionID)
+void FixAppOrchestrator::applyNewOrder(InboundRequest& request)
 {
-    try {
-        std::string orig;
-        auto order = FixMessageConverter::parseReplaceRequest(ocrr, orig);
-        SPDLOG_INFO("Processing OrderCancelReplaceRequest: ClOrdID={}, OrigClOrdID={}, Qty={}, Price={}", order.clOrdId,
-            orig, order.quantity, order.price);
-
-        auto r = svc_->processReplaceOrder(order, orig);
-        if (r.success) {
-            SPDLOG_INFO("Replace order accepted: ClOrdID={}, OrderID={}", order.clOrdId, r.orderId);
-            sendExecutionReport(r.updatedOrder, r.execId, "5", "5", sessionID); // REPLACED
-        } else {
-            SPDLOG_WARN("Replace order rejected: ClOrdID={}, Reason={}", order.clOrdId, r.message);
-            sendOrderReject(order.clOrdId, r.message, sessionID);
-        }
-    } catch (const std::exception& ex) {
-        SPDLOG_ERROR("OCrr error: {}", ex.what());
-        // 发送拒绝消息
-        try {
-            FIX::ClOrdID clOrdId;
-            ocrr.get(clOrdId);
-            sendOrderReject(clOrdId.getValue(), "Internal error processing replace request", sessionID);
-        } catch (...) {
-            SPDLOG_ERROR("Failed to send replace rejection message");
-        }
+    auto& order = request.order;
+    traffic_.event(TrafficFormat::NewOrder, order.clOrdId, order.symbol, order.quantity, order.price);
+
+    auto& session = sessions_.add(request.sessionID);
+    order.session = session.key();
+    if (duplicateClOrdId(session, order.clOrdId)) {
+        SPDLOG_WARN("Order rejected: duplicate ClOrdID={}", order.clOrdId);
+        reject(order.clOrdId, "Duplicate ClOrdID", request.sessionID);
+        return;
+    }
+
+    auto r = svc_->processNewOrder(order);
+    if (r.success) {
+        registerClOrdId(session, order.clOrdId);
+        SPDLOG_INFO("Order accepted: ClOrdID={}, OrderID={}", order.clOrdId, r.orderId);
+        session.subscribeAccount(r.updatedOrder.account);
+    } else {
+        SPDLOG_WARN("Order rejected: ClOrdID={}, Reason={}", order.clOrdId, r.message);
+        reject(order.clOrdId, r.message, request.sessionID);
     }
 }
 
-void FixAppOrchestrator::sendExecutionReport(const common::Order& order, const std::string& execId,
-    const std::string& execType, const std::string& ordStatus, const FIX::SessionID& sessionID)
+void FixAppOrchestrator::applyCancel(InboundRequest& request)
 {
-    auto m = FixMessageConverter::createExecutionReport(order, execId, execType, ordStatus, sessionID);
-    fix_sender_->sendToTarget(m, sessionID);
+    auto& order = request.order;
+    traffic_.event(TrafficFormat::CancelOrder, order.clOrdId, request.origClOrdId);
+
+    // 只能撤本会话下的订单
+    order.session = sessions_.add(request.sessionID).key();
+    auto r = svc_->processCancelOrder(order, request.origClOrdId);
+    if (r.success) {
+        SPDLOG_INFO("Cancel order accepted: ClOrdID={}, OrderID={}", order.clOrdId, r.orderId);
+    } else {
+        SPDLOG_WARN("Cancel order rejected: ClOrdID={}, Reason={}", order.clOrdId, r.message);
+        reject(order.clOrdId, r.message, request.sessionID);
+    }
 }
 
-void FixAppOrchestrator::sendOrderReject(
-    const std::string& clOrdId, const std::string& reason, const FIX::SessionID& sessionID)
+void FixAppOrchestrator::applyReplace(InboundRequest& request)
 {
-    auto m = FixMessageConverter::createOrderReject(clOrdId, reason, sessionID);
-    fix_sender_->sendToTarget(m, sessionID);
+    auto& order = request.order;
+    traffic_.event(
+        TrafficFormat::ReplaceOrder, order.clOrdId, request.origClOrdId, order.quantity, order.price);
+
+    // 改单成功后请求的 ClOrdID 即替换订单的 ClOrdID，与新单一样不得重复
+    auto& session = sessions_.add(request.sessionID);
+    order.session = session.key();
+    if (duplicateClOrdId(session, order.clOrdId)) {
+        SPDLOG_WARN("Replace order rejected: duplicate ClOrdID={}", order.clOrdId);
+        reject(order.clOrdId, "Duplicate ClOrdID", request.sessionID);
+        return;
+    }
+    auto r = svc_->processReplaceOrder(order, request.origClOrdId);
+    if (r.success) {
+        registerClOrdId(session, order.clOrdId);
+        SPDLOG_INFO("Replace order accepted: ClOrdID={}, OrderID={}", order.clOrdId, r.orderId);
+    } else {
+        SPDLOG_WARN("Replace order rejected: ClOrdID={}, Reason={}", order.clOrdId, r.message);
+        reject(order.clOrdId, r.message, request.sessionID);
+    }
 }
 
-void FixAppOrchestrator::sendMargin(const common::MarginUpdate& mu)
+void FixAppOrchestrator::rejectMalformed(const InboundRequest& request, const fixfield::Error& error)
+{
+    auto reason = fixfield::describe(error);
+    SPDLOG_WARN("Request rejected: ClOrdID={}, Reason={}", request.order.clOrdId, reason);
+    reject(request.order.clOrdId, reason, request.sessionID);
+}
+
+void FixAppOrchestrator::reject(const std::string& clOrdId, const std::string& reason, const FIX::SessionID& sessionID)
+{
+    // 就地发送（或经另一个发送线程）会越过还在事件总线上排队的、同一会话之前订单的确认
+    common::Order request;
+    request.clOrdId = clOrdId;
+    request.session = sessions_.add(sessionID).key();
+    svc_->publishReject(request, reason);
+}
+
+bool FixAppOrchestrator::duplicateClOrdId(const SessionContext& session, const std::string& clOrdId) const
+{
+    return !config_.disable_idempotence && session.clOrdIdUsed(clOrdId, utcDay());
+}
+
+void FixAppOrchestrator::registerClOrdId(SessionContext& session, const std::string& clOrdId)
 {
-    auto sid = getSessionId();
-    if (!sid)
+    if (!config_.disable_idempotence)
+        session.registerClOrdId(clOrdId, utcDay());
+}
+
+void FixAppOrchestrator::report(const common::Execution& execution)
+{
+    // 会话暂时断开时照常发送：QuickFIX 把报文写入消息存储，重连后按序号补发，成交回报不会丢失
+    auto* session = sessions_.find(execution.order.session);
+    if (!session) {
+        SPDLOG_WARN("Execution report dropped, unknown session: OrderID={}, Session={}", execution.order.orderId,
+            execution.order.session);
         return;
-    auto m = FixMessageConverter::createMarginUpdate(mu, *sid);
-    fix_sender_->sendToTarget(m, *sid);
+    }
+    if (execution.execType == "8")
+        sendOrderReject(execution.order.clOrdId, execution.text, session->id());
+    else
+        sendExecution(execution, session->id());
 }
 
-void FixAppOrchestrator::setSessionId(const FIX::SessionID& sessionID)
+void FixAppOrchestrator::sendExecution(const common::Execution& execution, const FIX::SessionID& sessionID)
 {
-    std::lock_guard<std::mutex> lk(session_mtx_);
-    session_id_ = sessionID;
+    auto m = FixMessageConverter::createExecutionReport(execution, sessionID);
+    fix_sender_->sendToTarget(m, sessionID);
 }
 
-void FixAppOrchestrator::clearSessionId()
+void FixAppOrchestrator::sendOrderReject(
+    const std::string& clOrdId, const std::string& reason, const FIX::SessionID& sessionID)
 {
-    std::lock_guard<std::mutex> lk(session_mtx_);
-    session_id_.reset();
+    auto m = FixMessageConverter::createOrderReject(clOrdId, reason, sessionID);
+    fix_sender_->sendToTarget(m, sessionID);
 }
 
-std::optional<FIX::SessionID> FixAppOrchestrator::getSessionId()
+void FixAppOrchestrator::sendMargin(const common::MarginUpdate& mu)
 {
-    std::lock_guard<std::mutex> lk(session_mtx_);
-    return session_id_;
+    sessions_.forEach([&](const SessionContext& session) {
+        if (!session.loggedOn() || !session.subscribed(mu.account))
+            return;
+        auto m = FixMessageConverter::createMarginUpdate(mu, session.id());
+        fix_sender_->sendToTarget(m, session.id());
+    });
 }
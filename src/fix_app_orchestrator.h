@@ -6,18 +6,26 @@
 #include <quickfix/fix44/OrderCancelRequest.h>
 #include <quickfix/fix44/OrderCancelReplaceRequest.h>
 
+#include "app_config.h"
 #include "domain_service.h"
 #include "fix_sender.h"
 #include "fix_message_converter.h"
+#include "queue_worker.h"
+#include "session_registry.h"
+#include "timer_scheduler.h"
+#include "traffic_log.h"
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
-#include <mutex>
-#include <optional>
+#include <string>
+#include <vector>
 
 class FixAppOrchestrator : public FIX::MessageCracker {
 public:
-    explicit FixAppOrchestrator(
-        std::unique_ptr<DomainService> svc, std::unique_ptr<FixSender> fix_sender = std::make_unique<QuickFixSender>());
+    explicit FixAppOrchestrator(std::unique_ptr<DomainService> svc,
+        std::unique_ptr<FixSender> fix_sender = std::make_unique<QuickFixSender>(), const ServerConfig& config = {});
+    ~FixAppOrchestrator();
 
     void onCreate(const FIX::SessionID& sessionID);
     void onLogon(const FIX::SessionID& sessionID);
@@ -32,19 +40,66 @@ public:
     void onMessage(const FIX44::OrderCancelRequest& ocr, const FIX::SessionID& sessionID) override;
     void onMessage(const FIX44::OrderCancelReplaceRequest& ocrr, const FIX::SessionID& sessionID) override;
 
+    // 流水线各级（decode / domain）的队列深度与延迟；未开启流水线时为空
+    std::vector<QueueMetrics> pipelineMetrics() const;
+
 private:
-    void sendExecutionReport(const common::Order& order, const std::string& execId, const std::string& execType,
-        const std::string& ordStatus, const FIX::SessionID& sessionID);
+    // 收到的应用层消息（原始报文），解码前
+    struct InboundMessage {
+        std::string raw;
+        FIX::SessionID sessionID;
+    };
+    // 解码后的订单请求
+    struct InboundRequest {
+        enum class Kind { NewOrder, Cancel, Replace };
+        Kind kind { Kind::NewOrder };
+        common::Order order;
+        std::string origClOrdId;
+        FIX::SessionID sessionID;
+        // 流水线解码级发现的格式错误，到领域级再拒绝，与之前请求的应答保持顺序
+        fixfield::Error error {};
+    };
+
+    void startPipeline();
+    void stopPipeline();
+    // 解码：拆出具体消息类型并交给 onMessage
+    void decode(const FIX::Message& message, const FIX::SessionID& sessionID);
+    // 流水线解码级：零拷贝扫描原始报文，不经过 FIX::Message
+    void decode(InboundMessage& message);
+    // 流水线模式下交给领域级线程，否则就地处理
+    void dispatch(InboundRequest& request);
+    void apply(InboundRequest& request);
+    void applyNewOrder(InboundRequest& request);
+    void applyCancel(InboundRequest& request);
+    void applyReplace(InboundRequest& request);
+    // 必填字段缺失或格式错误
+    void rejectMalformed(const InboundRequest& request, const fixfield::Error& error);
+    // 拒绝与执行回报经同一条路径（事件总线的 fix-reporter 线程）按序发出
+    void reject(const std::string& clOrdId, const std::string& reason, const FIX::SessionID& sessionID);
+    // 同一会话当天（UTC）已被接受的订单用过该 ClOrdID
+    bool duplicateClOrdId(const SessionContext& session, const std::string& clOrdId) const;
+    // 订单被接受后才登记 ClOrdID，被拒绝的请求可以用同一个 ClOrdID 重发。
+    // 同一会话的请求按序处理（QuickFIX 会话线程或流水线的领域线程），查询与登记之间不会插入同会话的请求
+    void registerClOrdId(SessionContext& session, const std::string& clOrdId);
+    // 执行回报（及拒绝）发往订单所属的会话
+    void report(const common::Execution& execution);
+    void sendExecution(const common::Execution& execution, const FIX::SessionID& sessionID);
     void sendOrderReject(const std::string& clOrdId, const std::string& reason, const FIX::SessionID& sessionID);
+    // 保证金推送给下过该账户订单、且在线的会话
     void sendMargin(const common::MarginUpdate& mu);
 
-    void setSessionId(const FIX::SessionID& sessionID);
-    void clearSessionId();
-    std::optional<FIX::SessionID> getSessionId();
-
 private:
     std::unique_ptr<DomainService> svc_;
     std::unique_ptr<FixSender> fix_sender_;
-    std::mutex session_mtx_;
-    std::optional<FIX::SessionID> session_id_;
+    ServerConfig config_;
+    // 报文与订单处理日志，须在所有会用到它的线程停止后析构
+    TrafficLog traffic_;
+    SessionRegistry sessions_;
+    std::atomic<std::size_t> logged_on_ { 0 };
+
+    // 流水线：socket 线程 -> decode -> domain，每级一个有界队列和一个线程。
+    // 出站只有一级：执行回报与拒绝都由事件总线的 fix-reporter 订阅线程构造与发送，同一会话的应答保持顺序
+    std::unique_ptr<QueueWorker<InboundRequest>> domain_;
+    std::unique_ptr<QueueWorker<InboundMessage>> decode_;
+    TimerId metrics_timer_ { kInvalidTimerId };
 };
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "common_types.h"
+#include "fix_schema.h"
+
 // FIX 4.4 保证金更新消息 (BI) 字段定义
 // 基于产品文档：Margin Update Message (tag 35=BI)
 namespace fixcustom {
@@ -19,6 +22,14 @@ inline constexpr int TAG_MARGIN_EXCESS = 899;    // 超额保证金 (MarginExces
 // 货币枚举值
 inline constexpr int CURRENCY_USD = 2;       // 美元
 
+// BI 的字段表，编码顺序与原来手写的一致；数值固定两位小数
+using MarginUpdateSchema = fixschema::Message<kMsgTypeMarginUpdate, common::MarginUpdate,
+    fixschema::Field<TAG_ACCOUNT, &common::MarginUpdate::account>,
+    fixschema::Field<TAG_CURRENCY, &common::MarginUpdate::currency>,
+    fixschema::Field<TAG_MARGIN_VALUE, &common::MarginUpdate::marginValue>,
+    fixschema::Field<TAG_MARGIN_LEVEL, &common::MarginUpdate::marginLevel>,
+    fixschema::Field<TAG_MARGIN_EXCESS, &common::MarginUpdate::marginExcess>>;
+
 }
 
 
@@ -0,0 +1,89 @@
+#include "fix_field.h"
+
+#include <charconv>
+
+namespace fixfield {
+
+std::string describe(const Error& error)
+{
+    switch (error.status) {
+    case Status::Ok:
+        return {};
+    case Status::Missing:
+        return "Missing required field " + std::to_string(error.tag);
+    case Status::Invalid:
+        break;
+    }
+    return "Invalid value for field " + std::to_string(error.tag);
+}
+
+const std::string* find(const FIX::FieldMap& map, int tag) noexcept
+{
+    const auto* field = map.getFieldPtrIfSet(tag);
+    return field ? &field->getString() : nullptr;
+}
+
+Status get(const FIX::FieldMap& map, int tag, std::string& out)
+{
+    const auto* value = find(map, tag);
+    if (!value)
+        return Status::Missing;
+    out = *value;
+    return Status::Ok;
+}
+
+Status get(const FIX::FieldMap& map, int tag, char& out) noexcept
+{
+    const auto* value = find(map, tag);
+    if (!value)
+        return Status::Missing;
+    if (value->size() != 1)
+        return Status::Invalid;
+    out = value->front();
+    return Status::Ok;
+}
+
+Status get(const FIX::FieldMap& map, int tag, double& out) noexcept
+{
+    const auto* value = find(map, tag);
+    if (!value)
+        return Status::Missing;
+    return toDouble(*value, out) ? Status::Ok : Status::Invalid;
+}
+
+Status get(const FIX::FieldMap& map, int tag, int& out) noexcept
+{
+    const auto* value = find(map, tag);
+    if (!value)
+        return Status::Missing;
+    return toInt(*value, out) ? Status::Ok : Status::Invalid;
+}
+
+bool toDouble(std::string_view text, double& out) noexcept
+{
+    // 与 QuickFIX 的 DoubleConvertor 一致：只接受定点格式，不接受指数和前导 '+'
+    if (text.empty())
+        return false;
+    const char* end = text.data() + text.size();
+    double value = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), end, value, std::chars_format::fixed);
+    if (ec != std::errc() || ptr != end)
+        return false;
+    out = value;
+    return true;
+}
+
+bool toInt(std::string_view text, int& out) noexcept
+{
+    if (text.empty())
+        return false;
+    const char* end = text.data() + text.size();
+    int value = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (ec != std::errc() || ptr != end)
+        return false;
+    out = value;
+    return true;
+}
+
+} // namespace fixfield
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "decimal.h"
+
+#include <quickfix/FieldMap.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// 不抛异常的字段读取。QuickFIX 的 get()/getField() 在字段缺失或格式错误时抛异常，
+// 畸形报文大量涌入时会变成异常风暴；这里按状态码返回，缺字段的拒绝与正常受理走同样的代码路径
+namespace fixfield {
+
+enum class Status : std::uint8_t { Ok, Missing, Invalid };
+
+// 第一个出错的字段
+struct Error {
+    Status status { Status::Ok };
+    int tag { 0 };
+
+    explicit operator bool() const { return status != Status::Ok; }
+};
+
+// 用作拒绝原因，例如 "Missing required field 38"
+std::string describe(const Error& error);
+
+// 字段未设置时返回 nullptr
+const std::string* find(const FIX::FieldMap& map, int tag) noexcept;
+
+Status get(const FIX::FieldMap& map, int tag, std::string& out);
+Status get(const FIX::FieldMap& map, int tag, char& out) noexcept;
+Status get(const FIX::FieldMap& map, int tag, double& out) noexcept;
+Status get(const FIX::FieldMap& map, int tag, int& out) noexcept;
+
+template <int Decimals>
+Status get(const FIX::FieldMap& map, int tag, common::Decimal<Decimals>& out) noexcept
+{
+    const auto* value = find(map, tag);
+    if (!value)
+        return Status::Missing;
+    return common::Decimal<Decimals>::parse(*value, out) ? Status::Ok : Status::Invalid;
+}
+
+// 失败时不修改 out
+bool toDouble(std::string_view text, double& out) noexcept;
+bool toInt(std::string_view text, int& out) noexcept;
+
+// 依次读取一条消息的字段，记录第一个错误，之后的读取跳过
+class Reader {
+public:
+    explicit Reader(const FIX::FieldMap& map)
+        : map_(map)
+    {
+    }
+
+    template <typename T>
+    Reader& required(int tag, T& out)
+    {
+        if (!error_)
+            check(tag, get(map_, tag, out));
+        return *this;
+    }
+
+    // 缺失时保留 out 原值，格式错误仍记为错误
+    template <typename T>
+    Reader& optional(int tag, T& out)
+    {
+        if (!error_) {
+            auto status = get(map_, tag, out);
+            if (status != Status::Missing)
+                check(tag, status);
+        }
+        return *this;
+    }
+
+    const Error& error() const { return error_; }
+
+private:
+    void check(int tag, Status status)
+    {
+        if (status != Status::Ok)
+            error_ = { status, tag };
+    }
+
+    const FIX::FieldMap& map_;
+    Error error_;
+};
+
+} // namespace fixfield
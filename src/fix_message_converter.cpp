@@ -1,5 +1,6 @@
 #include "fix_message_converter.h"
 #include "fix_custom.h"
+#include "utc_clock.h"
 
 #include <quickfix/Fields.h>
 #include <quickfix/fix44/NewOrderSingle.h>
@@ -8,122 +9,90 @@
 #include <quickfix/fix44/ExecutionReport.h>
 #include <quickfix/fix44/OrderCancelReject.h>
 
-#include <cstdio>
-
-common::Order FixMessageConverter::parseNewOrderSingle(const FIX44::NewOrderSingle& msg)
+fixfield::Error FixMessageConverter::parseNewOrderSingle(const FIX44::NewOrderSingle& msg, common::Order& out)
 {
-    common::Order o;
-    // Required
-    FIX::ClOrdID clOrdId;
-    msg.get(clOrdId);
-    o.clOrdId = clOrdId.getValue();
-    FIX::Side side;
-    msg.get(side);
-    o.side = side.getValue();
-    FIX::Symbol symbol;
-    msg.get(symbol);
-    o.symbol = symbol.getValue();
-    FIX::OrderQty qty;
-    msg.get(qty);
-    o.quantity = qty.getValue();
-    FIX::OrdType ordType;
-    msg.get(ordType);
-    o.orderType = ordType.getValue();
-    // Optional
-    if (msg.isSetField(FIX::FIELD::Price)) {
-        FIX::Price price;
-        msg.get(price);
-        o.price = price.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::TimeInForce)) {
-        FIX::TimeInForce tif;
-        msg.get(tif);
-        o.timeInForce = tif.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::Account)) {
-        FIX::Account account;
-        msg.get(account);
-        o.account = account.getValue();
-    }
-    return o;
+    // 数量与价格按定点数解析，与零拷贝解析（FixOrderParser）得到完全相同的 double
+    auto quantity = common::Fixed::fromDouble(out.quantity);
+    auto price = common::Fixed::fromDouble(out.price);
+    auto error = fixfield::Reader(msg)
+                     .required(FIX::FIELD::ClOrdID, out.clOrdId)
+                     .required(FIX::FIELD::Side, out.side)
+                     .required(FIX::FIELD::Symbol, out.symbol)
+                     .required(FIX::FIELD::OrderQty, quantity)
+                     .required(FIX::FIELD::OrdType, out.orderType)
+                     .optional(FIX::FIELD::Price, price)
+                     .optional(FIX::FIELD::TimeInForce, out.timeInForce)
+                     .optional(FIX::FIELD::Account, out.account)
+                     .error();
+    out.quantity = quantity.toDouble();
+    out.price = price.toDouble();
+    return error;
 }
 
-common::Order FixMessageConverter::parseCancelRequest(const FIX44::OrderCancelRequest& msg, std::string& outOrigClOrdId)
+fixfield::Error FixMessageConverter::parseCancelRequest(
+    const FIX44::OrderCancelRequest& msg, common::Order& out, std::string& outOrigClOrdId)
 {
-    common::Order o;
     outOrigClOrdId.clear();
-    if (msg.isSetField(FIX::FIELD::ClOrdID)) {
-        FIX::ClOrdID clOrdId;
-        msg.get(clOrdId);
-        o.clOrdId = clOrdId.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::OrigClOrdID)) {
-        FIX::OrigClOrdID orig;
-        msg.get(orig);
-        outOrigClOrdId = orig.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::Symbol)) {
-        FIX::Symbol symbol;
-        msg.get(symbol);
-        o.symbol = symbol.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::Side)) {
-        FIX::Side side;
-        msg.get(side);
-        o.side = side.getValue();
-    }
-    return o;
+    return fixfield::Reader(msg)
+        .required(FIX::FIELD::ClOrdID, out.clOrdId)
+        .required(FIX::FIELD::OrigClOrdID, outOrigClOrdId)
+        .optional(FIX::FIELD::Symbol, out.symbol)
+        .optional(FIX::FIELD::Side, out.side)
+        .optional(FIX::FIELD::Account, out.account)
+        .error();
 }
 
-common::Order FixMessageConverter::parseReplaceRequest(
-    const FIX44::OrderCancelReplaceRequest& msg, std::string& outOrigClOrdId)
+fixfield::Error FixMessageConverter::parseReplaceRequest(
+    const FIX44::OrderCancelReplaceRequest& msg, common::Order& out, std::string& outOrigClOrdId)
 {
-    common::Order o;
     outOrigClOrdId.clear();
-    if (msg.isSetField(FIX::FIELD::ClOrdID)) {
-        FIX::ClOrdID clOrdId;
-        msg.get(clOrdId);
-        o.clOrdId = clOrdId.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::OrigClOrdID)) {
-        FIX::OrigClOrdID orig;
-        msg.get(orig);
-        outOrigClOrdId = orig.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::Symbol)) {
-        FIX::Symbol symbol;
-        msg.get(symbol);
-        o.symbol = symbol.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::Side)) {
-        FIX::Side side;
-        msg.get(side);
-        o.side = side.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::OrderQty)) {
-        FIX::OrderQty qty;
-        msg.get(qty);
-        o.quantity = qty.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::Price)) {
-        FIX::Price price;
-        msg.get(price);
-        o.price = price.getValue();
-    }
-    if (msg.isSetField(FIX::FIELD::OrdType)) {
-        FIX::OrdType ordType;
-        msg.get(ordType);
-        o.orderType = ordType.getValue();
-    }
-    return o;
+    auto quantity = common::Fixed::fromDouble(out.quantity);
+    auto price = common::Fixed::fromDouble(out.price);
+    auto error = fixfield::Reader(msg)
+                     .required(FIX::FIELD::ClOrdID, out.clOrdId)
+                     .required(FIX::FIELD::OrigClOrdID, outOrigClOrdId)
+                     .optional(FIX::FIELD::Symbol, out.symbol)
+                     .optional(FIX::FIELD::Side, out.side)
+                     .optional(FIX::FIELD::OrderQty, quantity)
+                     .optional(FIX::FIELD::Price, price)
+                     .optional(FIX::FIELD::OrdType, out.orderType)
+                     .optional(FIX::FIELD::TimeInForce, out.timeInForce)
+                     .optional(FIX::FIELD::Account, out.account)
+                     .error();
+    out.quantity = quantity.toDouble();
+    out.price = price.toDouble();
+    return error;
+}
+
+void FixMessageConverter::toOrder(const InboundOrderView& view, common::Order& out, std::string& outOrigClOrdId)
+{
+    out.clOrdId.assign(view.clOrdId);
+    outOrigClOrdId.assign(view.origClOrdId);
+    if (!view.symbol.empty())
+        out.symbol.assign(view.symbol);
+    if (!view.account.empty())
+        out.account.assign(view.account);
+    if (view.side)
+        out.side = view.side;
+    if (view.orderType)
+        out.orderType = view.orderType;
+    if (view.timeInForce)
+        out.timeInForce = view.timeInForce;
+    if (view.hasQuantity)
+        out.quantity = view.quantity.toDouble();
+    if (view.hasPrice)
+        out.price = view.price.toDouble();
 }
 
 FIX::Message FixMessageConverter::createExecutionReport(const common::Order& order, const std::string& execId,
     const std::string& execType, const std::string& ordStatus, const FIX::SessionID&)
 {
+    // 终态订单不再有剩余数量
+    auto state = common::parseOrderState(order.status);
+    auto leaves = common::isOpen(state) ? order.quantity - order.cumQty : 0.0;
     FIX44::ExecutionReport er(FIX::OrderID(order.orderId), FIX::ExecID(execId), FIX::ExecType(execType[0]),
-        FIX::OrdStatus(ordStatus[0]), FIX::Side(order.side), FIX::LeavesQty(static_cast<double>(order.quantity)),
-        FIX::CumQty(0), FIX::AvgPx(0));
+        FIX::OrdStatus(ordStatus[0]), FIX::Side(order.side), FIX::LeavesQty(leaves), FIX::CumQty(order.cumQty),
+        FIX::AvgPx(order.avgPx));
     er.set(FIX::ClOrdID(order.clOrdId));
     if (!order.symbol.empty())
         er.set(FIX::Symbol(order.symbol));
@@ -131,7 +100,21 @@ FIX::Message FixMessageConverter::createExecutionReport(const common::Order& ord
     er.set(FIX::OrdType(order.orderType));
     if (order.price > 0)
         er.set(FIX::Price(order.price));
-    er.setField(FIX::TransactTime());
+    er.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
+    return er;
+}
+
+FIX::Message FixMessageConverter::createExecutionReport(
+    const common::Execution& execution, const FIX::SessionID& sessionID)
+{
+    auto er = createExecutionReport(
+        execution.order, execution.execId, execution.execType, execution.ordStatus, sessionID);
+    if (execution.lastQty > 0) {
+        er.setField(FIX::LastQty(execution.lastQty));
+        er.setField(FIX::LastPx(execution.lastPx));
+    }
+    if (!execution.origClOrdId.empty())
+        er.setField(FIX::OrigClOrdID(execution.origClOrdId));
     return er;
 }
 
@@ -143,7 +126,7 @@ FIX::Message FixMessageConverter::createOrderReject(
     rej.setField(FIX::CxlRejResponseTo(FIX::CxlRejResponseTo_ORDER_CANCEL_REQUEST));
     rej.setField(FIX::CxlRejReason(99));
     rej.setField(FIX::Text(reason));
-    rej.setField(FIX::TransactTime());
+    rej.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
     return rej;
 }
 
@@ -151,24 +134,11 @@ FIX::Message FixMessageConverter::createMarginUpdate(const common::MarginUpdate&
 {
     FIX::Message msg;
     msg.getHeader().setField(FIX::BeginString(FIX::BeginString_FIX44));
-    msg.getHeader().setField(FIX::MsgType(fixcustom::kMsgTypeMarginUpdate));
-
-    // 设置标准字段
-    msg.setField(FIX::Account(update.account));
-    msg.setField(FIX::Currency(update.currency));
-
-    // 确保数值字段格式正确
-    char buf1[64], buf2[64], buf3[64];
-    std::snprintf(buf1, sizeof(buf1), "%.2f", update.marginValue);
-    std::snprintf(buf2, sizeof(buf2), "%.2f", update.marginLevel);
-    std::snprintf(buf3, sizeof(buf3), "%.2f", update.marginExcess);
-
-    msg.setField(fixcustom::TAG_MARGIN_VALUE, std::string(buf1));
-    msg.setField(fixcustom::TAG_MARGIN_LEVEL, std::string(buf2));
-    msg.setField(fixcustom::TAG_MARGIN_EXCESS, std::string(buf3));
+    // MsgType 与各字段按 BI 的字段表写入，数值固定两位小数
+    fixcustom::MarginUpdateSchema::encode(update, msg);
 
     // 添加时间戳
-    msg.setField(FIX::TransactTime());
+    msg.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
 
     return msg;
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "common_types.h"
+#include "fix_field.h"
+#include "fix_order_parser.h"
 
 #include <quickfix/Message.h>
 #include <quickfix/SessionID.h>
@@ -12,12 +14,19 @@
 class FixMessageConverter {
 public:
     // Overloads for FIX44 strong types to avoid dynamic_cast path issues
-    static common::Order parseNewOrderSingle(const FIX44::NewOrderSingle& msg);
-    static common::Order parseCancelRequest(const FIX44::OrderCancelRequest& msg, std::string& outOrigClOrdId);
-    static common::Order parseReplaceRequest(const FIX44::OrderCancelReplaceRequest& msg, std::string& outOrigClOrdId);
+    // 不抛异常：必填字段缺失或字段格式错误时返回第一个出错的字段
+    static fixfield::Error parseNewOrderSingle(const FIX44::NewOrderSingle& msg, common::Order& out);
+    static fixfield::Error parseCancelRequest(
+        const FIX44::OrderCancelRequest& msg, common::Order& out, std::string& outOrigClOrdId);
+    static fixfield::Error parseReplaceRequest(
+        const FIX44::OrderCancelReplaceRequest& msg, common::Order& out, std::string& outOrigClOrdId);
+    // 零拷贝解析（FixOrderParser）的结果转为订单，只复制订单用到的字段；未出现的字段保留 out 原值
+    static void toOrder(const InboundOrderView& view, common::Order& out, std::string& outOrigClOrdId);
 
     static FIX::Message createExecutionReport(const common::Order& order, const std::string& execId,
         const std::string& execType, const std::string& ordStatus, const FIX::SessionID& sessionID);
+    // 成交回报（ExecType F）带 LastQty/LastPx，改单确认（ExecType 5）带 OrigClOrdID
+    static FIX::Message createExecutionReport(const common::Execution& execution, const FIX::SessionID& sessionID);
 
     static FIX::Message createOrderReject(
         const std::string& clOrdId, const std::string& reason, const FIX::SessionID& sessionID);
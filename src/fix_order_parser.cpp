@@ -0,0 +1,178 @@
+#include "fix_order_parser.h"
+
+#include "fix_simd.h"
+
+#include <quickfix/Fields.h>
+
+#include <span>
+
+namespace {
+
+constexpr char kSoh = '\x01';
+// 一次查找的 SOH 个数上限，覆盖常见报文的全部字段
+constexpr std::size_t kSohBatch = 64;
+
+enum : unsigned {
+    kClOrdId = 1 << 0,
+    kOrigClOrdId = 1 << 1,
+    kSymbol = 1 << 2,
+    kSide = 1 << 3,
+    kOrderQty = 1 << 4,
+    kOrdType = 1 << 5,
+    kPrice = 1 << 6,
+    kTimeInForce = 1 << 7,
+    kAccount = 1 << 8,
+};
+
+struct FieldCheck {
+    unsigned bit;
+    int tag;
+    bool required;
+};
+
+// 与 FixMessageConverter 中 fixfield::Reader 的读取顺序一致，报告的是按此顺序第一个缺失或格式错误的字段
+constexpr FieldCheck kNewOrderChecks[] = {
+    { kClOrdId, FIX::FIELD::ClOrdID, true },
+    { kSide, FIX::FIELD::Side, true },
+    { kSymbol, FIX::FIELD::Symbol, true },
+    { kOrderQty, FIX::FIELD::OrderQty, true },
+    { kOrdType, FIX::FIELD::OrdType, true },
+    { kPrice, FIX::FIELD::Price, false },
+    { kTimeInForce, FIX::FIELD::TimeInForce, false },
+    { kAccount, FIX::FIELD::Account, false },
+};
+
+constexpr FieldCheck kCancelChecks[] = {
+    { kClOrdId, FIX::FIELD::ClOrdID, true },
+    { kOrigClOrdId, FIX::FIELD::OrigClOrdID, true },
+    { kSymbol, FIX::FIELD::Symbol, false },
+    { kSide, FIX::FIELD::Side, false },
+    { kAccount, FIX::FIELD::Account, false },
+};
+
+constexpr FieldCheck kReplaceChecks[] = {
+    { kClOrdId, FIX::FIELD::ClOrdID, true },
+    { kOrigClOrdId, FIX::FIELD::OrigClOrdID, true },
+    { kSymbol, FIX::FIELD::Symbol, false },
+    { kSide, FIX::FIELD::Side, false },
+    { kOrderQty, FIX::FIELD::OrderQty, false },
+    { kPrice, FIX::FIELD::Price, false },
+    { kOrdType, FIX::FIELD::OrdType, false },
+    { kTimeInForce, FIX::FIELD::TimeInForce, false },
+    { kAccount, FIX::FIELD::Account, false },
+};
+
+bool toChar(std::string_view text, char& out)
+{
+    if (text.size() != 1)
+        return false;
+    out = text.front();
+    return true;
+}
+
+} // namespace
+
+fixfield::Error FixOrderParser::parse(std::string_view raw, InboundOrderView& out) noexcept
+{
+    out = {};
+    unsigned seen = 0;
+    unsigned invalid = 0;
+
+    // 先用向量化内核一次找出一批 SOH 的位置，再逐个字段只解析很短的 tag
+    std::uint32_t sohs[kSohBatch];
+    std::size_t count = 0;
+    std::size_t next = 0;
+    std::size_t offset = 0;
+    const char* const base = raw.data();
+    std::size_t pos = 0;
+    while (pos < raw.size()) {
+        if (next == count) {
+            offset = pos;
+            count = fixsimd::findAll(raw.substr(offset), kSoh, sohs, kSohBatch);
+            next = 0;
+        }
+        // 最后一个字段可以没有结尾的 SOH
+        std::size_t end = next < count ? offset + sohs[next++] : raw.size();
+        int tag = 0;
+        std::size_t p = pos;
+        for (; p < end && base[p] != '='; ++p) {
+            if (base[p] < '0' || base[p] > '9' || p - pos >= 9)
+                return { fixfield::Status::Invalid, 0 };
+            tag = tag * 10 + (base[p] - '0');
+        }
+        if (p == end && end < raw.size())
+            return { fixfield::Status::Invalid, 0 };
+        if (p == end || p == pos)
+            break;
+        std::string_view value(base + p + 1, end - p - 1);
+        pos = end + 1;
+
+        switch (tag) {
+        case FIX::FIELD::MsgType:
+            out.msgType = value;
+            break;
+        case FIX::FIELD::ClOrdID:
+            out.clOrdId = value;
+            seen |= kClOrdId;
+            break;
+        case FIX::FIELD::OrigClOrdID:
+            out.origClOrdId = value;
+            seen |= kOrigClOrdId;
+            break;
+        case FIX::FIELD::Symbol:
+            out.symbol = value;
+            seen |= kSymbol;
+            break;
+        case FIX::FIELD::Account:
+            out.account = value;
+            seen |= kAccount;
+            break;
+        case FIX::FIELD::Side:
+            if (!toChar(value, out.side))
+                invalid |= kSide;
+            seen |= kSide;
+            break;
+        case FIX::FIELD::OrdType:
+            if (!toChar(value, out.orderType))
+                invalid |= kOrdType;
+            seen |= kOrdType;
+            break;
+        case FIX::FIELD::TimeInForce:
+            if (!toChar(value, out.timeInForce))
+                invalid |= kTimeInForce;
+            seen |= kTimeInForce;
+            break;
+        case FIX::FIELD::OrderQty:
+            out.hasQuantity = common::Fixed::parse(value, out.quantity);
+            if (!out.hasQuantity)
+                invalid |= kOrderQty;
+            seen |= kOrderQty;
+            break;
+        case FIX::FIELD::Price:
+            out.hasPrice = common::Fixed::parse(value, out.price);
+            if (!out.hasPrice)
+                invalid |= kPrice;
+            seen |= kPrice;
+            break;
+        default:
+            break;
+        }
+    }
+
+    std::span<const FieldCheck> checks;
+    if (out.msgType == FIX::MsgType_NewOrderSingle)
+        checks = kNewOrderChecks;
+    else if (out.msgType == FIX::MsgType_OrderCancelRequest)
+        checks = kCancelChecks;
+    else if (out.msgType == FIX::MsgType_OrderCancelReplaceRequest)
+        checks = kReplaceChecks;
+    for (const auto& check : checks) {
+        if (!(seen & check.bit)) {
+            if (check.required)
+                return { fixfield::Status::Missing, check.tag };
+        } else if (invalid & check.bit) {
+            return { fixfield::Status::Invalid, check.tag };
+        }
+    }
+    return {};
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "decimal.h"
+#include "fix_field.h"
+
+#include <string_view>
+
+// 35=D/F/G 的零拷贝视图：字符串字段指向原始报文缓冲（缓冲须比视图活得久），数值为定点数
+struct InboundOrderView {
+    std::string_view msgType;
+    std::string_view clOrdId;
+    std::string_view origClOrdId;
+    std::string_view symbol;
+    std::string_view account;
+    char side { 0 };
+    char orderType { 0 };
+    char timeInForce { 0 };
+    common::Fixed quantity;
+    common::Fixed price;
+    bool hasQuantity { false };
+    bool hasPrice { false };
+};
+
+// 直接扫描 tag=value<SOH> 原始报文，一次遍历填出 InboundOrderView，不分配内存、不抛异常。
+// 报文的分帧、BodyLength 与 CheckSum 由会话层校验，这里不再检查。
+class FixOrderParser {
+public:
+    // 非 D/F/G 报文只填 msgType 并返回 Ok；必填字段缺失或格式错误时，按 FixMessageConverter 的读取顺序返回第一个出错的字段
+    static fixfield::Error parse(std::string_view raw, InboundOrderView& out) noexcept;
+};
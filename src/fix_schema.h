@@ -0,0 +1,222 @@
+#pragma once
+
+#include "decimal.h"
+#include "fix_field.h"
+
+#include <quickfix/Fields.h>
+#include <quickfix/Message.h>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// 编译期消息定义：字段的 tag、类型、必填/可选和对应的结构体成员只声明一次，
+// 由此生成固定顺序的编码器和单次遍历的解码器，字段分派在编译期展开，运行时不查表。
+// 可选字段必须是 std::optional 成员、tag 不得重复、字段须属于同一结构体，这些在编译期检查。
+//
+//   using MarginUpdateSchema = fixschema::Message<kMsgTypeMarginUpdate, common::MarginUpdate,
+//       fixschema::Field<1, &common::MarginUpdate::account>, ...>;
+namespace fixschema {
+
+enum class Presence : std::uint8_t { Required, Optional };
+
+namespace detail {
+
+template <typename T>
+struct IsOptional : std::false_type { };
+template <typename T>
+struct IsOptional<std::optional<T>> : std::true_type { };
+
+template <typename M>
+struct MemberOf;
+template <typename C, typename V>
+struct MemberOf<V C::*> {
+    using Struct = C;
+    using Value = V;
+};
+
+// 按整数收发的类型：char 是单字符字段，bool 不是数值
+template <typename T>
+inline constexpr bool IsInteger = std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>;
+
+// 值 -> 字段文本
+inline void set(FIX::FieldMap& map, int tag, const std::string& value) { map.setField(tag, value); }
+
+inline void set(FIX::FieldMap& map, int tag, char value) { map.setField(tag, std::string(1, value)); }
+
+template <typename T, std::enable_if_t<IsInteger<T>, int> = 0>
+void set(FIX::FieldMap& map, int tag, T value)
+{
+    char buf[24];
+    auto end = std::to_chars(buf, buf + sizeof(buf), value).ptr;
+    map.setField(tag, std::string(buf, end));
+}
+
+// 固定 Decimals 位小数
+template <int Decimals>
+void set(FIX::FieldMap& map, int tag, common::Decimal<Decimals> value)
+{
+    char buf[common::Decimal<Decimals>::kMaxChars];
+    auto end = value.toChars(buf, buf + sizeof(buf), Decimals).ptr;
+    map.setField(tag, std::string(buf, end));
+}
+
+template <typename T>
+void set(FIX::FieldMap& map, int tag, const std::optional<T>& value)
+{
+    if (value)
+        set(map, tag, *value);
+}
+
+// 字段文本 -> 值，失败时不修改 out
+inline bool parse(std::string_view text, std::string& out)
+{
+    out.assign(text);
+    return true;
+}
+
+inline bool parse(std::string_view text, char& out)
+{
+    if (text.size() != 1)
+        return false;
+    out = text.front();
+    return true;
+}
+
+template <typename T, std::enable_if_t<IsInteger<T>, int> = 0>
+bool parse(std::string_view text, T& out)
+{
+    const char* end = text.data() + text.size();
+    T value {};
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    if (text.empty() || ec != std::errc() || ptr != end)
+        return false;
+    out = value;
+    return true;
+}
+
+template <int Decimals>
+bool parse(std::string_view text, common::Decimal<Decimals>& out)
+{
+    return common::Decimal<Decimals>::parse(text, out);
+}
+
+template <typename T>
+bool parse(std::string_view text, std::optional<T>& out)
+{
+    T value {};
+    if (!parse(text, value))
+        return false;
+    out = std::move(value);
+    return true;
+}
+
+template <std::size_t N>
+constexpr bool uniqueTags(const int (&tags)[N])
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        if (tags[i] <= 0)
+            return false;
+        for (std::size_t j = i + 1; j < N; ++j) {
+            if (tags[i] == tags[j])
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+// 一个字段：tag 与结构体成员；可选字段的成员须为 std::optional，缺失时保持 nullopt、编码时跳过
+template <int Tag, auto Member, Presence P = Presence::Required>
+struct Field {
+    using Struct = typename detail::MemberOf<decltype(Member)>::Struct;
+    using Value = typename detail::MemberOf<decltype(Member)>::Value;
+
+    static constexpr int tag = Tag;
+    static constexpr auto member = Member;
+    static constexpr Presence presence = P;
+
+    static_assert((P == Presence::Optional) == detail::IsOptional<Value>::value,
+        "fixschema::Field: optional fields must be std::optional members and required fields must not be");
+};
+
+// 一种消息：MsgType、对应结构体与字段表；编码按字段表的顺序写入
+template <const char* MsgType, typename Struct, typename... Fields>
+class Message {
+    static constexpr int kTags[] = { Fields::tag... };
+
+    static_assert(sizeof...(Fields) > 0 && sizeof...(Fields) <= 64, "fixschema::Message: 1..64 fields");
+    static_assert((std::is_same_v<typename Fields::Struct, Struct> && ...),
+        "fixschema::Message: every field must be a member of the message struct");
+    static_assert(detail::uniqueTags(kTags), "fixschema::Message: tags must be positive and unique");
+
+    template <std::size_t I>
+    using FieldAt = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    template <std::size_t... I>
+    static constexpr std::uint64_t requiredMask(std::index_sequence<I...>)
+    {
+        return ((FieldAt<I>::presence == Presence::Required ? std::uint64_t { 1 } << I : 0) | ...);
+    }
+
+public:
+    static constexpr std::string_view msgType { MsgType };
+    static constexpr std::size_t kFieldCount = sizeof...(Fields);
+    static constexpr std::uint64_t kRequired = requiredMask(std::index_sequence_for<Fields...> {});
+
+    // 写入 MsgType 与各字段；BeginString、时间戳等其他字段由调用方补充
+    static void encode(const Struct& in, FIX::Message& out)
+    {
+        out.getHeader().setField(FIX::FIELD::MsgType, std::string(msgType));
+        (detail::set(out, Fields::tag, in.*Fields::member), ...);
+    }
+
+    // 遍历一次报文体：每个字段按 tag 在编译期展开的比较中分派到成员，不在字段表里的忽略。
+    // 缺必填字段优先于格式错误；出错时已解析的成员保留新值
+    static fixfield::Error decode(const FIX::FieldMap& in, Struct& out)
+    {
+        std::uint64_t seen = 0;
+        fixfield::Error invalid;
+        for (auto it = in.begin(); it != in.end(); ++it)
+            dispatch(it->getTag(), it->getString(), out, seen, invalid, std::index_sequence_for<Fields...> {});
+        if (auto missing = kRequired & ~seen)
+            return { fixfield::Status::Missing, tagOf(missing) };
+        return invalid;
+    }
+
+private:
+    template <std::size_t... I>
+    static void dispatch(int tag, std::string_view text, Struct& out, std::uint64_t& seen, fixfield::Error& invalid,
+        std::index_sequence<I...>)
+    {
+        (void)((FieldAt<I>::tag == tag && (accept<I>(text, out, seen, invalid), true)) || ...);
+    }
+
+    template <std::size_t I>
+    static void accept(std::string_view text, Struct& out, std::uint64_t& seen, fixfield::Error& invalid)
+    {
+        using F = FieldAt<I>;
+        seen |= std::uint64_t { 1 } << I;
+        if (!detail::parse(text, out.*F::member) && !invalid)
+            invalid = { fixfield::Status::Invalid, F::tag };
+    }
+
+    // 按字段表顺序取第一个缺失字段的 tag
+    static int tagOf(std::uint64_t missing)
+    {
+        for (std::size_t i = 0; i < kFieldCount; ++i) {
+            if (missing & (std::uint64_t { 1 } << i))
+                return kTags[i];
+        }
+        return 0;
+    }
+};
+
+} // namespace fixschema
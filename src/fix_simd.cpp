@@ -0,0 +1,188 @@
+#include "fix_simd.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FIXSIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要按函数开启指令集，MSVC 可以直接使用内建函数
+#if defined(FIXSIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define FIXSIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define FIXSIMD_TARGET(isa)
+#endif
+
+namespace fixsimd {
+
+namespace {
+
+std::size_t findAllScalar(const char* data, std::size_t size, char c, std::uint32_t* out, std::size_t max)
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < size && n < max; ++i) {
+        if (data[i] == c)
+            out[n++] = static_cast<std::uint32_t>(i);
+    }
+    return n;
+}
+
+#if defined(FIXSIMD_X86)
+
+// 把一个块的比较掩码展开成下标
+inline std::size_t emit(std::uint32_t mask, std::size_t base, std::uint32_t* out, std::size_t n, std::size_t max)
+{
+    while (mask && n < max) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long bit;
+        _BitScanForward(&bit, mask);
+#else
+        unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        out[n++] = static_cast<std::uint32_t>(base + bit);
+        mask &= mask - 1;
+    }
+    return n;
+}
+
+// 不足一个块的尾部按标量处理
+inline std::size_t findTail(
+    const char* data, std::size_t from, std::size_t size, char c, std::uint32_t* out, std::size_t n, std::size_t max)
+{
+    for (std::size_t i = from; i < size && n < max; ++i) {
+        if (data[i] == c)
+            out[n++] = static_cast<std::uint32_t>(i);
+    }
+    return n;
+}
+
+FIXSIMD_TARGET("sse4.2")
+std::size_t findAllSse42(const char* data, std::size_t size, char c, std::uint32_t* out, std::size_t max)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    std::size_t n = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= size && n < max; i += 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        n = emit(mask, i, out, n, max);
+    }
+    return findTail(data, i, size, c, out, n, max);
+}
+
+FIXSIMD_TARGET("avx2")
+std::size_t findAllAvx2(const char* data, std::size_t size, char c, std::uint32_t* out, std::size_t max)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    std::size_t n = 0;
+    std::size_t i = 0;
+    for (; i + 32 <= size && n < max; i += 32) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        n = emit(mask, i, out, n, max);
+    }
+    n = findTail(data, i, size, c, out, n, max);
+    // 返回到非 VEX 编码的代码前清掉 YMM 高位，避免 AVX/SSE 切换惩罚
+    _mm256_zeroupper();
+    return n;
+}
+
+bool cpuSupports(Level level)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool sse42 = (info[2] & (1 << 20)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (level == Level::Sse42)
+        return sse42;
+    if (level != Level::Avx2 || maxLeaf < 7 || !osxsave || !avx)
+        return level == Level::Scalar;
+    // 操作系统须保存 YMM 状态
+    if ((_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    switch (level) {
+    case Level::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case Level::Sse42:
+        return __builtin_cpu_supports("sse4.2");
+    case Level::Scalar:
+        break;
+    }
+    return true;
+#endif
+}
+
+#else
+
+bool cpuSupports(Level level) { return level == Level::Scalar; }
+
+#endif
+
+Level detect()
+{
+    if (cpuSupports(Level::Avx2))
+        return Level::Avx2;
+    if (cpuSupports(Level::Sse42))
+        return Level::Sse42;
+    return Level::Scalar;
+}
+
+std::atomic<Level>& current()
+{
+    static std::atomic<Level> level { detect() };
+    return level;
+}
+
+} // namespace
+
+Level level() { return current().load(std::memory_order_relaxed); }
+
+const char* levelName(Level level)
+{
+    switch (level) {
+    case Level::Avx2:
+        return "avx2";
+    case Level::Sse42:
+        return "sse4.2";
+    case Level::Scalar:
+        break;
+    }
+    return "scalar";
+}
+
+Level setLevel(Level level)
+{
+    while (level != Level::Scalar && !cpuSupports(level))
+        level = static_cast<Level>(static_cast<int>(level) - 1);
+    current().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+std::size_t findAll(std::string_view text, char c, std::uint32_t* out, std::size_t max)
+{
+#if defined(FIXSIMD_X86)
+    switch (level()) {
+    case Level::Avx2:
+        return findAllAvx2(text.data(), text.size(), c, out, max);
+    case Level::Sse42:
+        return findAllSse42(text.data(), text.size(), c, out, max);
+    case Level::Scalar:
+        break;
+    }
+#endif
+    return findAllScalar(text.data(), text.size(), c, out, max);
+}
+
+} // namespace fixsimd
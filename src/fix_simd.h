@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// FIX 报文扫描用的向量化内核：按字节查找（SOH / '='）。
+// 分帧与 BodyLength、CheckSum 的计算和校验都在 QuickFIX 会话层内完成，这里不重复实现。
+// 首次调用时按 CPU 特性选择 AVX2 / SSE4.2 / 标量实现，三者结果逐字节一致。
+namespace fixsimd {
+
+enum class Level { Scalar, Sse42, Avx2 };
+
+// 当前使用的实现
+Level level();
+const char* levelName(Level level);
+// 强制使用某一实现（不超过 CPU 支持的级别），用于对比测试；返回实际生效的级别
+Level setLevel(Level level);
+
+// text 中所有等于 c 的字节的下标，最多写 max 个，返回写入的个数（等于 max 时可能还有剩余）
+std::size_t findAll(std::string_view text, char c, std::uint32_t* out, std::size_t max);
+
+} // namespace fixsimd
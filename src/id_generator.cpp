@@ -0,0 +1,105 @@
+#include "id_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <utility>
+
+#include "utc_clock.h"
+
+namespace {
+
+constexpr int kSeqBits = 12;
+constexpr int kNodeShift = kSeqBits;
+constexpr int kTimeShift = kSeqBits + IdGenerator::kNodeBits;
+constexpr std::uint64_t kSeqMask = (std::uint64_t { 1 } << kSeqBits) - 1;
+// 2024-01-01T00:00:00Z
+constexpr std::int64_t kEpochMs = 1704067200000;
+// 每次预留的序号数，线程在同一毫秒内发号超过这个数才再次访问全局计数器
+constexpr std::uint64_t kBlock = 64;
+
+constexpr char kAlphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+std::atomic<std::uint32_t> g_node { 0 };
+// 下一个未预留的 (毫秒 << 12 | 序号)，所有线程共享
+std::atomic<std::uint64_t> g_next { 0 };
+
+std::int64_t nowMs() { return UtcClock::nowNs() / 1000000 - kEpochMs; }
+
+// 字符 -> 数值，非法字符为 -1
+constexpr auto kDigits = [] {
+    std::array<std::int8_t, 256> table {};
+    table.fill(-1);
+    for (int i = 0; i < 32; ++i)
+        table[static_cast<unsigned char>(kAlphabet[i])] = static_cast<std::int8_t>(i);
+    return table;
+}();
+
+inline int digitOf(char c) { return kDigits[static_cast<unsigned char>(c)]; }
+
+// 每一位单独由移位得到、互不依赖，在编译期展开
+template <std::size_t... I>
+inline void encodeDigits(char* out, std::uint64_t id, std::index_sequence<I...>)
+{
+    ((out[I] = kAlphabet[(id >> (5 * (sizeof...(I) - 1 - I))) & 31]), ...);
+}
+
+} // namespace
+
+void IdGenerator::configure(std::uint32_t node) { g_node.store(std::min(node, kMaxNode), std::memory_order_relaxed); }
+
+std::uint64_t IdGenerator::next()
+{
+    struct Block {
+        std::uint64_t next { 0 };
+        std::uint64_t end { 0 };
+    };
+    thread_local Block block;
+
+    // 平时不读时钟：段用完，或其他线程已在更晚的毫秒预留过（说明本段已过时），才按当前时间重新预留
+    if (block.next == block.end || (g_next.load(std::memory_order_relaxed) >> kSeqBits) > (block.end >> kSeqBits)) {
+        auto floor = static_cast<std::uint64_t>(std::max<std::int64_t>(nowMs(), 0)) << kSeqBits;
+        auto current = g_next.load(std::memory_order_relaxed);
+        std::uint64_t base;
+        do {
+            base = std::max(current, floor);
+        } while (!g_next.compare_exchange_weak(current, base + kBlock, std::memory_order_relaxed));
+        block = { base, base + kBlock };
+    }
+    auto value = block.next++;
+    // 序号溢出时进位到毫秒部分（借用下一毫秒）
+    return (value >> kSeqBits) << kTimeShift
+        | static_cast<std::uint64_t>(g_node.load(std::memory_order_relaxed)) << kNodeShift | (value & kSeqMask);
+}
+
+IdText IdGenerator::encode(std::uint64_t id)
+{
+    IdText text;
+    encodeDigits(text.data, id, std::make_index_sequence<IdText::kSize> {});
+    return text;
+}
+
+std::optional<std::uint64_t> IdGenerator::decode(std::string_view text)
+{
+    // 13 位共 65 位，最高位字符只能取 0~15
+    if (text.size() != IdText::kSize || digitOf(text.front()) > 15)
+        return std::nullopt;
+    std::uint64_t id = 0;
+    for (char c : text) {
+        auto d = digitOf(c);
+        if (d < 0)
+            return std::nullopt;
+        id = id << 5 | static_cast<std::uint64_t>(d);
+    }
+    return id;
+}
+
+std::int64_t IdGenerator::timestampMs(std::uint64_t id)
+{
+    return static_cast<std::int64_t>(id >> kTimeShift) + kEpochMs;
+}
+
+std::uint32_t IdGenerator::node(std::uint64_t id)
+{
+    return static_cast<std::uint32_t>(id >> kNodeShift) & kMaxNode;
+}
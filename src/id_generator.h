@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// 定长 ID 文本，存放在对象内部，不分配内存
+struct IdText {
+    static constexpr std::size_t kSize = 13;
+
+    char data[kSize];
+
+    std::string_view view() const { return { data, kSize }; }
+    operator std::string_view() const { return view(); }
+};
+
+// 进程内共享的 64 位 ID 生成器（OrderID / ExecID / ClOrdID）：
+//   [0][41 位毫秒，自 2024-01-01 UTC 起][10 位节点号][12 位序号]
+// 每个线程从全局计数器以 CAS 预留一小段连续序号，段内发号只动线程本地变量、不读时钟；
+// 段用完或其他线程已在更晚的毫秒预留过时，按当前时间重新预留，因此时间戳是段的预留时刻，
+// 各线程发出的 ID 大致按时间排序。计数器不小于"当前毫秒 << 12"，
+// 单毫秒超过 4096 个时向后借用下一毫秒，ID 在进程内严格唯一。
+// 不同进程实例靠节点号区分，重启后时间戳前进即不会与上次运行重复（不依赖日志恢复计数器）。
+// 文本为 13 位 Crockford Base32，定长、按字典序即按时间排序，放得进 std::string 的短字符串缓冲。
+// 线程安全；configure() 应在启动时、发号之前调用。
+class IdGenerator {
+public:
+    static constexpr int kNodeBits = 10;
+    static constexpr std::uint32_t kMaxNode = (1u << kNodeBits) - 1;
+
+    static void configure(std::uint32_t node);
+
+    static std::uint64_t next();
+    static IdText nextText() { return encode(next()); }
+
+    static IdText encode(std::uint64_t id);
+    // 只接受 encode() 产生的 13 位文本
+    static std::optional<std::uint64_t> decode(std::string_view text);
+
+    // 生成时刻（Unix 纪元毫秒）与节点号
+    static std::int64_t timestampMs(std::uint64_t id);
+    static std::uint32_t node(std::uint64_t id);
+};
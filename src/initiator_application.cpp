@@ -2,9 +2,10 @@
 
 #include <spdlog/spdlog.h>
 
-InitiatorApplication::InitiatorApplication()
+InitiatorApplication::InitiatorApplication(const AppConfig& config)
     // inject domain service instead of constructing it in the constructor to make it more convenient for unit-testing
-    : orchestrator_(std::make_unique<FixAppOrchestrator>(std::make_unique<DomainService>()))
+    : orchestrator_(std::make_unique<FixAppOrchestrator>(
+          std::make_unique<DomainService>(config.domain), std::make_unique<QuickFixSender>(), config.server))
 {
 }
 
@@ -6,11 +6,12 @@
 
 #include <memory>
 
+#include "app_config.h"
 #include "fix_app_orchestrator.h"
 
 class InitiatorApplication : public FIX::Application {
 public:
-    InitiatorApplication();
+    explicit InitiatorApplication(const AppConfig& config = {});
     ~InitiatorApplication() = default;
     void onCreate(const FIX::SessionID& sessionID) override;
     void onLogon(const FIX::SessionID& sessionID) override;
@@ -0,0 +1,156 @@
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+LatencyHistogram::LatencyHistogram()
+    : counts_(std::make_unique<std::atomic<std::uint64_t>[]>(kBuckets))
+    , min_(std::numeric_limits<std::int64_t>::max())
+{
+}
+
+std::size_t LatencyHistogram::indexOf(std::int64_t ns)
+{
+    constexpr auto kMax = (std::int64_t { 1 } << kMaxBits) - 1;
+    auto v = static_cast<std::uint64_t>(std::clamp<std::int64_t>(ns, 0, kMax));
+    if (v < static_cast<std::uint64_t>(kSubBuckets))
+        return static_cast<std::size_t>(v);
+    // [2^(10+b), 2^(11+b)) 内的值右移 b 位落在 [1024, 2048)，每个区间占 1024 个桶
+    auto shift = std::bit_width(v) - kSubBucketBits;
+    return static_cast<std::size_t>(shift) * (kSubBuckets / 2) + static_cast<std::size_t>(v >> shift);
+}
+
+std::int64_t LatencyHistogram::lowestAt(std::size_t index)
+{
+    if (index < static_cast<std::size_t>(kSubBuckets))
+        return static_cast<std::int64_t>(index);
+    auto shift = index / (kSubBuckets / 2) - 1;
+    return static_cast<std::int64_t>(index - shift * (kSubBuckets / 2)) << shift;
+}
+
+std::int64_t LatencyHistogram::highestAt(std::size_t index)
+{
+    if (index < static_cast<std::size_t>(kSubBuckets))
+        return static_cast<std::int64_t>(index);
+    auto shift = index / (kSubBuckets / 2) - 1;
+    return lowestAt(index) + (std::int64_t { 1 } << shift) - 1;
+}
+
+void LatencyHistogram::record(std::int64_t ns)
+{
+    ns = std::max<std::int64_t>(ns, 0);
+    counts_[indexOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    auto lo = min_.load(std::memory_order_relaxed);
+    while (ns < lo && !min_.compare_exchange_weak(lo, ns, std::memory_order_relaxed)) {
+    }
+    auto hi = max_.load(std::memory_order_relaxed);
+    while (ns > hi && !max_.compare_exchange_weak(hi, ns, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::size_t i = 0; i < kBuckets; ++i)
+        counts_[i].store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<std::int64_t>::max(), std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+std::int64_t LatencyHistogram::min() const { return count() == 0 ? 0 : min_.load(std::memory_order_relaxed); }
+
+double LatencyHistogram::mean() const
+{
+    double sum = 0;
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        if (auto n = counts_[i].load(std::memory_order_relaxed)) {
+            sum += static_cast<double>(n) * ((lowestAt(i) + highestAt(i)) / 2.0);
+            total += n;
+        }
+    }
+    return total == 0 ? 0 : sum / static_cast<double>(total);
+}
+
+double LatencyHistogram::stddev() const
+{
+    auto m = mean();
+    double sum = 0;
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        if (auto n = counts_[i].load(std::memory_order_relaxed)) {
+            auto d = (lowestAt(i) + highestAt(i)) / 2.0 - m;
+            sum += static_cast<double>(n) * d * d;
+            total += n;
+        }
+    }
+    return total == 0 ? 0 : std::sqrt(sum / static_cast<double>(total));
+}
+
+std::int64_t LatencyHistogram::percentile(double p) const
+{
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i)
+        total += counts_[i].load(std::memory_order_relaxed);
+    if (total == 0)
+        return 0;
+    auto target = static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(total)));
+    target = std::clamp<std::uint64_t>(target, 1, total);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= target)
+            return std::min(highestAt(i), max());
+    }
+    return max();
+}
+
+void LatencyHistogram::print(std::ostream& out) const
+{
+    // 与 HdrHistogram outputPercentileDistribution 相同：每个"到 100% 的一半距离"内输出 5 行
+    constexpr int kTicksPerHalfDistance = 5;
+    char line[128];
+    std::snprintf(line, sizeof(line), "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount",
+        "1/(1-Percentile)");
+    out << line;
+
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i)
+        total += counts_[i].load(std::memory_order_relaxed);
+    auto top = max();
+    double fraction = 0;
+    std::uint64_t seen = 0;
+    std::size_t i = 0;
+    while (total > 0) {
+        auto target = std::clamp<std::uint64_t>(
+            static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(total))), 1, total);
+        for (; seen < target && i < kBuckets; ++i)
+            seen += counts_[i].load(std::memory_order_relaxed);
+        auto value = std::min(highestAt(i == 0 ? 0 : i - 1), top) / 1000.0;
+        if (seen >= total || i == kBuckets) {
+            std::snprintf(line, sizeof(line), "%12.3f %1.12f %10llu\n", value, 1.0,
+                static_cast<unsigned long long>(seen));
+            out << line;
+            break;
+        }
+        std::snprintf(line, sizeof(line), "%12.3f %1.12f %10llu %14.2f\n", value, fraction,
+            static_cast<unsigned long long>(seen), 1.0 / (1.0 - fraction));
+        out << line;
+        auto halfDistance = std::exp2(std::floor(std::log2(1.0 / (1.0 - fraction))) + 1);
+        fraction += 1.0 / (kTicksPerHalfDistance * halfDistance);
+    }
+
+    std::snprintf(line, sizeof(line), "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean() / 1000.0,
+        stddev() / 1000.0);
+    out << line;
+    std::snprintf(line, sizeof(line), "#[Max     = %12.3f, Total count    = %12llu]\n", top / 1000.0,
+        static_cast<unsigned long long>(total));
+    out << line;
+    std::snprintf(line, sizeof(line), "#[Buckets = %12d, SubBuckets     = %12lld]\n", kMaxBits - kSubBucketBits + 1,
+        static_cast<long long>(kSubBuckets));
+    out << line;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+// HDR 风格的延迟直方图（纳秒）：每个 2 的幂区间再等分为 1024 个子桶，相对误差不超过 1/1024（3 位有效数字），
+// 覆盖 0 ~ 2^43ns（约 2.4 小时），超出的值记在最后一个桶。
+// 计数是原子的，多个线程可同时 record()；读取（percentile / print）得到的是近似同一时刻的快照。
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(std::int64_t ns);
+    void reset();
+
+    std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    std::int64_t min() const;
+    std::int64_t max() const { return max_.load(std::memory_order_relaxed); }
+    double mean() const;
+    double stddev() const;
+    // p 为 0~100；返回该分位所在桶的上界（与 HDR 的 highestEquivalentValue 一致），不超过 max()
+    std::int64_t percentile(double p) const;
+
+    // HdrHistogram 的 percentile distribution 文本格式（值以微秒输出），可直接用 HdrHistogram 的绘图工具打开
+    void print(std::ostream& out) const;
+
+private:
+    static constexpr int kSubBucketBits = 11;
+    static constexpr std::int64_t kSubBuckets = std::int64_t { 1 } << kSubBucketBits;
+    static constexpr int kMaxBits = 43;
+    static constexpr std::size_t kBuckets = (kMaxBits - kSubBucketBits + 2) * (kSubBuckets / 2);
+
+    static std::size_t indexOf(std::int64_t ns);
+    static std::int64_t lowestAt(std::size_t index);
+    static std::int64_t highestAt(std::size_t index);
+
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counts_;
+    std::atomic<std::uint64_t> count_ { 0 };
+    std::atomic<std::int64_t> min_;
+    std::atomic<std::int64_t> max_ { 0 };
+};
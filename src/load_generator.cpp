@@ -0,0 +1,384 @@
+#include "load_generator.h"
+
+#include <quickfix/Fields.h>
+#include <quickfix/Session.h>
+#include <quickfix/fix44/NewOrderSingle.h>
+#include <quickfix/fix44/OrderCancelReplaceRequest.h>
+#include <quickfix/fix44/OrderCancelRequest.h>
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <fstream>
+
+#include "id_generator.h"
+#include "utc_clock.h"
+
+namespace {
+
+constexpr const char* kKindNames[] = { "market", "limit", "cancel", "replace", "invalid" };
+
+std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+template <int N>
+std::string text(common::Decimal<N> value)
+{
+    char buf[common::Decimal<N>::kMaxChars];
+    return { buf, value.toChars(buf, buf + sizeof(buf)).ptr };
+}
+
+// p50 ~ p99.99 与最大值，单位微秒
+std::string summarize(const LatencyHistogram& h)
+{
+    auto us = [&](double p) { return h.percentile(p) / 1000.0; };
+    return fmt::format("p50={:.1f} p90={:.1f} p99={:.1f} p99.9={:.1f} p99.99={:.1f} max={:.1f} mean={:.1f}", us(50),
+        us(90), us(99), us(99.9), us(99.99), h.max() / 1000.0, h.mean() / 1000.0);
+}
+
+} // namespace
+
+LoadGenerator::LoadGenerator(const LoadTestConfig& config, const FIX::SessionID& sessionID)
+    : config_(config)
+    , session_(sessionID)
+    , rng_(std::random_device {}())
+    , mix_(config.mix.begin(), config.mix.end())
+{
+}
+
+LoadGenerator::~LoadGenerator()
+{
+    requestStop();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void LoadGenerator::start()
+{
+    if (thread_.joinable())
+        return;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { run(); });
+}
+
+void LoadGenerator::requestStop()
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+}
+
+void LoadGenerator::run()
+{
+    const std::uint64_t total = static_cast<std::uint64_t>(config_.rate) * config_.duration_s;
+    SPDLOG_INFO("Load test started: rate={}/s, duration={}s, session={}", config_.rate, config_.duration_s,
+        session_.toString());
+    started_ns_ = nowNs();
+    for (std::uint64_t i = 0; i < total; ++i) {
+        // 排定时刻只由序号决定，与前一个请求何时发出、是否已应答无关
+        auto intended = started_ns_ + static_cast<std::int64_t>(i * 1000000000ULL / config_.rate);
+        if (!waitUntil(intended))
+            break;
+        auto* session = FIX::Session::lookupSession(session_);
+        if (!session || !session->isLoggedOn()) {
+            SPDLOG_WARN("Load test aborted: session {} is not logged on", session_.toString());
+            break;
+        }
+        sendOne(static_cast<Kind>(mix_(rng_)), intended);
+    }
+    send_end_ns_ = nowNs();
+    drain();
+    finished_ns_ = nowNs();
+
+    logSummary();
+    if (!config_.report_file.empty()) {
+        std::ofstream out(config_.report_file, std::ios::trunc);
+        if (out) {
+            printReport(out);
+            SPDLOG_INFO("Load test report written to {}", config_.report_file);
+        } else {
+            SPDLOG_ERROR("Failed to open load test report file {}", config_.report_file);
+        }
+    }
+    running_.store(false, std::memory_order_release);
+}
+
+bool LoadGenerator::waitUntil(std::int64_t ns)
+{
+    // 距离较远时休眠，最后 200us 让出 CPU 等待，避免休眠精度不足导致系统性晚发
+    constexpr std::int64_t kSpinNs = 200000;
+    auto remaining = ns - nowNs();
+    if (remaining > kSpinNs) {
+        std::unique_lock<std::mutex> lk(mtx_);
+        if (cv_.wait_for(lk, std::chrono::nanoseconds(remaining - kSpinNs), [this] { return stop_; }))
+            return false;
+    }
+    while (nowNs() < ns)
+        std::this_thread::yield();
+    std::lock_guard<std::mutex> lk(mtx_);
+    return !stop_;
+}
+
+void LoadGenerator::drain()
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(config_.drain_s);
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (in_flight_.load(std::memory_order_acquire) > 0 && !stop_) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+            break;
+        cv_.wait_until(lk, std::min(deadline, now + std::chrono::milliseconds(10)));
+    }
+    lk.unlock();
+
+    // 剩下的请求计为丢失
+    for (auto& stripe : stripes_) {
+        std::lock_guard<std::mutex> slk(stripe.mtx);
+        lost_ += stripe.pending.size();
+        stripe.pending.clear();
+        stripe.origins.clear();
+    }
+}
+
+void LoadGenerator::sendOne(Kind kind, std::int64_t intended_ns)
+{
+    // 与上一轮压测、其他进程的 ClOrdID 都不重复（服务端按会话、交易日去重）
+    std::string clOrdId(IdGenerator::nextText());
+    Pending pending;
+    pending.intended_ns = intended_ns;
+    if ((kind == Kind::Cancel || kind == Kind::Replace) && !takeOpenOrder(pending.order))
+        kind = Kind::Limit;
+    pending.kind = kind;
+
+    FIX::Message msg;
+    std::string origClOrdId;
+    switch (kind) {
+    case Kind::Cancel:
+        msg = buildCancel(clOrdId, pending.order);
+        origClOrdId = pending.order.clOrdId;
+        break;
+    case Kind::Replace:
+        msg = buildReplace(clOrdId, pending.order);
+        break;
+    default:
+        msg = buildNewOrder(kind, clOrdId, pending.order);
+        break;
+    }
+
+    // 先登记再发送，应答可能在 sendToTarget 返回前到达
+    in_flight_.fetch_add(1, std::memory_order_relaxed);
+    if (!origClOrdId.empty()) {
+        auto& stripe = stripeOf(origClOrdId);
+        std::lock_guard<std::mutex> lk(stripe.mtx);
+        stripe.origins[origClOrdId] = clOrdId;
+    }
+    {
+        auto& stripe = stripeOf(clOrdId);
+        std::lock_guard<std::mutex> lk(stripe.mtx);
+        pending.sent_ns = nowNs();
+        stripe.pending.emplace(clOrdId, std::move(pending));
+    }
+    counters_[kind].sent.fetch_add(1, std::memory_order_relaxed);
+    try {
+        FIX::Session::sendToTarget(msg, session_);
+    } catch (const std::exception& ex) {
+        SPDLOG_ERROR("Load test send error: ClOrdID={}, {}", clOrdId, ex.what());
+        onCancelReject(clOrdId);
+    }
+}
+
+FIX::Message LoadGenerator::buildNewOrder(Kind kind, const std::string& clOrdId, OpenOrder& order)
+{
+    order.clOrdId = clOrdId;
+    order.symbol = static_cast<std::uint32_t>(rng_() % config_.symbols.size());
+    order.account = static_cast<std::uint32_t>(rng_() % config_.accounts.size());
+    order.side = rng_() % 2 == 0 ? FIX::Side_BUY : FIX::Side_SELL;
+    order.quantity = common::Fixed::fromRaw(static_cast<std::int64_t>(rng_() % 10 + 1) * 10 * common::Fixed::kScale);
+
+    FIX44::NewOrderSingle nos;
+    nos.setField(FIX::ClOrdID(clOrdId));
+    nos.setField(FIX::Side(order.side));
+    nos.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
+    nos.setField(FIX::Account(config_.accounts[order.account]));
+    nos.setField(FIX::TimeInForce(FIX::TimeInForce_DAY));
+    switch (kind) {
+    case Kind::Limit: {
+        // 买单低于、卖单高于参考价 1%~3%，彼此不成交，且在风控的价格带之内
+        auto offset = static_cast<double>(rng_() % 201 + 100) / 10000.0;
+        auto price = common::Money::fromDouble(config_.price * (order.side == FIX::Side_BUY ? 1 - offset : 1 + offset));
+        order.price = price.rescale<common::Fixed::kDecimals>();
+        nos.setField(FIX::OrdType(FIX::OrdType_LIMIT));
+        nos.setField(FIX::Symbol(config_.symbols[order.symbol]));
+        nos.setField(FIX::FIELD::OrderQty, text(order.quantity));
+        nos.setField(FIX::FIELD::Price, text(price));
+        break;
+    }
+    case Kind::Invalid:
+        nos.setField(FIX::OrdType(FIX::OrdType_MARKET));
+        nos.setField(FIX::Symbol("INVALID"));
+        nos.setField(FIX::OrderQty(-10));
+        break;
+    default:
+        nos.setField(FIX::OrdType(FIX::OrdType_MARKET));
+        nos.setField(FIX::Symbol(config_.symbols[order.symbol]));
+        nos.setField(FIX::FIELD::OrderQty, text(order.quantity));
+        break;
+    }
+    return nos;
+}
+
+FIX::Message LoadGenerator::buildCancel(const std::string& clOrdId, const OpenOrder& target)
+{
+    FIX44::OrderCancelRequest ocr;
+    ocr.setField(FIX::ClOrdID(clOrdId));
+    ocr.setField(FIX::OrigClOrdID(target.clOrdId));
+    ocr.setField(FIX::Symbol(config_.symbols[target.symbol]));
+    ocr.setField(FIX::Side(target.side));
+    ocr.setField(FIX::Account(config_.accounts[target.account]));
+    ocr.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
+    return ocr;
+}
+
+FIX::Message LoadGenerator::buildReplace(const std::string& clOrdId, const OpenOrder& target)
+{
+    auto quantity = replaceQuantity(target);
+    FIX44::OrderCancelReplaceRequest ocrr;
+    ocrr.setField(FIX::ClOrdID(clOrdId));
+    ocrr.setField(FIX::OrigClOrdID(target.clOrdId));
+    ocrr.setField(FIX::Symbol(config_.symbols[target.symbol]));
+    ocrr.setField(FIX::Side(target.side));
+    ocrr.setField(FIX::Account(config_.accounts[target.account]));
+    ocrr.setField(FIX::FIELD::OrderQty, text(quantity));
+    ocrr.setField(FIX::FIELD::Price, text(target.price));
+    ocrr.setField(FIX::OrdType(FIX::OrdType_LIMIT));
+    ocrr.setField(FIX::FIELD::TransactTime, std::string(UtcClock::now()));
+    return ocrr;
+}
+
+common::Fixed LoadGenerator::replaceQuantity(const OpenOrder& target)
+{
+    // 数量加 10，价格不变
+    return target.quantity + common::Fixed::fromRaw(10 * common::Fixed::kScale);
+}
+
+void LoadGenerator::onExecutionReport(const std::string& clOrdId, char execType)
+{
+    // 撤单确认带原订单的 ClOrdID；原订单自身的撤销（如市价单剩余部分）不在映射中，按本身的 ClOrdID 处理
+    if (execType == '4') {
+        std::string request;
+        {
+            auto& stripe = stripeOf(clOrdId);
+            std::lock_guard<std::mutex> lk(stripe.mtx);
+            if (auto it = stripe.origins.find(clOrdId); it != stripe.origins.end()) {
+                request = std::move(it->second);
+                stripe.origins.erase(it);
+            }
+        }
+        if (!request.empty()) {
+            complete(request, true, execType);
+            return;
+        }
+    }
+    complete(clOrdId, execType != '8', execType);
+}
+
+void LoadGenerator::onCancelReject(const std::string& clOrdId) { complete(clOrdId, false, 0); }
+
+void LoadGenerator::complete(const std::string& clOrdId, bool accepted, char execType)
+{
+    auto now = nowNs();
+    Pending pending;
+    {
+        auto& stripe = stripeOf(clOrdId);
+        std::lock_guard<std::mutex> lk(stripe.mtx);
+        auto it = stripe.pending.find(clOrdId);
+        // 同一请求的后续应答（如成交回报）或已计为丢失的请求
+        if (it == stripe.pending.end())
+            return;
+        pending = std::move(it->second);
+        stripe.pending.erase(it);
+    }
+    in_flight_.fetch_sub(1, std::memory_order_release);
+
+    corrected_.record(now - pending.intended_ns);
+    raw_.record(now - pending.sent_ns);
+    by_kind_[pending.kind].record(now - pending.intended_ns);
+    auto& counters = counters_[pending.kind];
+    (accepted ? counters.acked : counters.rejected).fetch_add(1, std::memory_order_relaxed);
+
+    if (pending.kind == Kind::Cancel) {
+        // 被拒绝时映射还在；目标订单可能已成交，不再放回
+        auto& stripe = stripeOf(pending.order.clOrdId);
+        std::lock_guard<std::mutex> lk(stripe.mtx);
+        if (auto it = stripe.origins.find(pending.order.clOrdId); it != stripe.origins.end() && it->second == clOrdId)
+            stripe.origins.erase(it);
+    } else if (pending.kind == Kind::Replace && accepted && execType == '5') {
+        // 替换订单以请求的 ClOrdID 继续挂单；被拒绝时目标订单可能已成交，不再放回
+        pending.order.clOrdId = clOrdId;
+        pending.order.quantity = replaceQuantity(pending.order);
+        std::lock_guard<std::mutex> lk(pool_mtx_);
+        pool_.push_back(std::move(pending.order));
+    } else if (pending.kind == Kind::Limit && accepted && execType == '0') {
+        std::lock_guard<std::mutex> lk(pool_mtx_);
+        pool_.push_back(std::move(pending.order));
+    }
+}
+
+bool LoadGenerator::takeOpenOrder(OpenOrder& out)
+{
+    std::lock_guard<std::mutex> lk(pool_mtx_);
+    if (pool_.empty())
+        return false;
+    out = std::move(pool_.front());
+    pool_.pop_front();
+    return true;
+}
+
+LoadGenerator::Stripe& LoadGenerator::stripeOf(const std::string& clOrdId)
+{
+    return stripes_[std::hash<std::string> {}(clOrdId) % kStripes];
+}
+
+void LoadGenerator::logSummary() const
+{
+    std::uint64_t sent = 0;
+    std::uint64_t completed = 0;
+    for (const auto& c : counters_) {
+        sent += c.sent.load(std::memory_order_relaxed);
+        completed += c.acked.load(std::memory_order_relaxed) + c.rejected.load(std::memory_order_relaxed);
+    }
+    auto send_s = std::max<std::int64_t>(send_end_ns_ - started_ns_, 1) / 1e9;
+    auto total_s = std::max<std::int64_t>(finished_ns_ - started_ns_, 1) / 1e9;
+    SPDLOG_INFO("Load test finished: sent={} in {:.2f}s ({:.0f}/s, target {}/s), responses={} in {:.2f}s ({:.0f}/s), "
+                "lost={}",
+        sent, send_s, sent / send_s, config_.rate, completed, total_s, completed / total_s, lost_);
+    SPDLOG_INFO("Latency corrected (us): {}", summarize(corrected_));
+    SPDLOG_INFO("Latency raw (us): {}", summarize(raw_));
+    for (int k = 0; k < LoadTestConfig::KindCount; ++k) {
+        const auto& c = counters_[k];
+        if (c.sent.load(std::memory_order_relaxed) == 0)
+            continue;
+        SPDLOG_INFO("  {}: sent={} acked={} rejected={} {}", kKindNames[k], c.sent.load(std::memory_order_relaxed),
+            c.acked.load(std::memory_order_relaxed), c.rejected.load(std::memory_order_relaxed),
+            summarize(by_kind_[k]));
+    }
+}
+
+void LoadGenerator::printReport(std::ostream& out) const
+{
+    out << "# Corrected round-trip latency (us), measured from the intended send time\n";
+    corrected_.print(out);
+    out << "\n# Raw round-trip latency (us), measured from the actual send time\n";
+    raw_.print(out);
+    for (int k = 0; k < LoadTestConfig::KindCount; ++k) {
+        if (by_kind_[k].count() == 0)
+            continue;
+        out << "\n# " << kKindNames[k] << " (corrected, us)\n";
+        by_kind_[k].print(out);
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <quickfix/Message.h>
+#include <quickfix/SessionID.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "app_config.h"
+#include "decimal.h"
+#include "latency_histogram.h"
+
+// 开环压测：发送线程按 rate 预先排定第 i 个请求的发送时刻 t0 + i/rate，不等待应答；
+// 落后时立即补发，延迟从排定时刻算起（校正协调遗漏），另记一份从实际发送时刻算起的原始延迟。
+// 在途请求按 ClOrdID 记在分条带加锁的表中，收到第一条应答（ER 或 OrderCancelReject）即完成一次往返。
+// 撤单的确认 ER 带的是原订单的 ClOrdID，因此另按 OrigClOrdID 记一份到请求 ClOrdID 的映射；
+// 改单确认带的是替换订单（即请求）的 ClOrdID，替换订单随后放回可撤/改的订单池。
+// 结束时把 p50~p99.99 与吞吐写入日志，完整分布写入 report_file。
+// 应答回调可在任意线程调用；start()/requestStop() 不阻塞，析构时等待发送线程退出。
+class LoadGenerator {
+public:
+    LoadGenerator(const LoadTestConfig& config, const FIX::SessionID& sessionID);
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    void start();
+    // 停止发送并跳过等待应答，随后照常输出报告；可在 QuickFIX 回调内调用
+    void requestStop();
+    bool running() const { return running_.load(std::memory_order_acquire); }
+
+    void onExecutionReport(const std::string& clOrdId, char execType);
+    void onCancelReject(const std::string& clOrdId);
+
+    // HdrHistogram 格式的完整延迟分布（校正后与原始各一份）
+    void printReport(std::ostream& out) const;
+
+private:
+    using Kind = LoadTestConfig::Kind;
+
+    // 已确认、可撤/改的限价单
+    struct OpenOrder {
+        std::string clOrdId;
+        std::uint32_t symbol { 0 };
+        std::uint32_t account { 0 };
+        char side { '1' };
+        common::Fixed quantity;
+        common::Fixed price;
+    };
+
+    struct Pending {
+        std::int64_t intended_ns { 0 };
+        std::int64_t sent_ns { 0 };
+        Kind kind { Kind::Market };
+        // 新单为订单本身，撤单/改单为目标订单
+        OpenOrder order;
+    };
+
+    struct alignas(64) Stripe {
+        std::mutex mtx;
+        std::unordered_map<std::string, Pending> pending;
+        // OrigClOrdID -> 撤单请求的 ClOrdID
+        std::unordered_map<std::string, std::string> origins;
+    };
+
+    struct alignas(64) Counters {
+        std::atomic<std::uint64_t> sent { 0 };
+        std::atomic<std::uint64_t> acked { 0 };
+        std::atomic<std::uint64_t> rejected { 0 };
+    };
+
+    static constexpr std::size_t kStripes = 64;
+
+    void run();
+    bool waitUntil(std::int64_t ns);
+    void drain();
+    void sendOne(Kind kind, std::int64_t intended_ns);
+    FIX::Message buildNewOrder(Kind kind, const std::string& clOrdId, OpenOrder& order);
+    FIX::Message buildCancel(const std::string& clOrdId, const OpenOrder& target);
+    FIX::Message buildReplace(const std::string& clOrdId, const OpenOrder& target);
+    static common::Fixed replaceQuantity(const OpenOrder& target);
+    void complete(const std::string& clOrdId, bool accepted, char execType);
+    bool takeOpenOrder(OpenOrder& out);
+    void logSummary() const;
+    Stripe& stripeOf(const std::string& clOrdId);
+
+    LoadTestConfig config_;
+    FIX::SessionID session_;
+    std::mt19937_64 rng_;
+    std::discrete_distribution<int> mix_;
+
+    std::array<Stripe, kStripes> stripes_;
+    std::atomic<std::uint64_t> in_flight_ { 0 };
+    std::mutex pool_mtx_;
+    std::deque<OpenOrder> pool_;
+
+    std::array<Counters, LoadTestConfig::KindCount> counters_;
+    std::uint64_t lost_ { 0 };
+    std::int64_t started_ns_ { 0 };
+    std::int64_t send_end_ns_ { 0 };
+    std::int64_t finished_ns_ { 0 };
+    LatencyHistogram corrected_;
+    LatencyHistogram raw_;
+    std::array<LatencyHistogram, LoadTestConfig::KindCount> by_kind_;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool stop_ { false };
+    std::atomic<bool> running_ { false };
+    std::thread thread_;
+};
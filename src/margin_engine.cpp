@@ -0,0 +1,100 @@
+#include "margin_engine.h"
+
+#include <cmath>
+#include <functional>
+
+MarginEngine::MarginEngine(const MarginConfig& config)
+    : config_(config)
+{
+}
+
+void MarginEngine::onOrderOpened(const common::Order& order) { apply(order.account, notionalOf(order), 1); }
+
+void MarginEngine::onOrderClosed(const common::Order& order) { apply(order.account, -notionalOf(order), -1); }
+
+void MarginEngine::onOrderFilled(const common::Order& before, const common::Order& after)
+{
+    auto closed = common::isTerminal(common::parseOrderState(after.status)) ? -1 : 0;
+    apply(after.account, notionalOf(after) - notionalOf(before), closed);
+}
+
+common::MarginUpdate MarginEngine::marginOf(const std::string& account) const
+{
+    const auto& stripe = stripeOf(account);
+    std::lock_guard<std::mutex> lk(stripe.mtx);
+    auto it = stripe.accounts.find(account);
+    return compute(account, it == stripe.accounts.end() ? Account {} : it->second);
+}
+
+std::vector<common::MarginUpdate> MarginEngine::drainChanged()
+{
+    std::vector<common::MarginUpdate> updates;
+    for (auto& stripe : stripes_) {
+        std::lock_guard<std::mutex> lk(stripe.mtx);
+        for (const auto& name : stripe.changed) {
+            auto& account = stripe.accounts[name];
+            account.changed = false;
+            updates.push_back(compute(name, account));
+        }
+        stripe.changed.clear();
+    }
+    return updates;
+}
+
+std::size_t MarginEngine::accountCount() const
+{
+    std::size_t n = 0;
+    for (const auto& stripe : stripes_) {
+        std::lock_guard<std::mutex> lk(stripe.mtx);
+        n += stripe.accounts.size();
+    }
+    return n;
+}
+
+std::int64_t MarginEngine::notionalOf(const common::Order& order)
+{
+    // 先规整到存储使用的定点数：挂单时的原始订单与撤单时从存储还原的订单算出的值完全相同，
+    // 整数累加不会产生漂移。市价单没有价格，只计入挂单数
+    auto quantity = common::fromFixed(common::toFixed(order.quantity) - common::toFixed(order.cumQty));
+    auto price = common::fromFixed(common::toFixed(order.price));
+    return static_cast<std::int64_t>(std::llround(quantity * price * kNotionalScale));
+}
+
+MarginEngine::Stripe& MarginEngine::stripeOf(const std::string& account)
+{
+    return stripes_[std::hash<std::string> {}(account) % kStripes];
+}
+
+const MarginEngine::Stripe& MarginEngine::stripeOf(const std::string& account) const
+{
+    return stripes_[std::hash<std::string> {}(account) % kStripes];
+}
+
+void MarginEngine::apply(const std::string& name, std::int64_t notional, int orders)
+{
+    auto& stripe = stripeOf(name);
+    std::lock_guard<std::mutex> lk(stripe.mtx);
+    auto& account = stripe.accounts[name];
+    account.open_notional += notional;
+    account.open_orders += orders;
+    if (!account.changed) {
+        account.changed = true;
+        stripe.changed.push_back(name);
+    }
+}
+
+common::MarginUpdate MarginEngine::compute(const std::string& account, const Account& a) const
+{
+    common::MarginUpdate mu;
+    mu.account = account;
+    mu.currency = config_.currency;
+    // 占用保证金 = 挂单名义金额 / 杠杆；保证金水平 = 净值 / 占用保证金（%），无占用时为 0。
+    // 结果按 Money 精度取整，之后的加减都是精确的整数运算
+    auto notional = static_cast<double>(a.open_notional) / kNotionalScale;
+    auto balance = common::Money::fromDouble(config_.balance);
+    mu.marginValue = common::Money::fromDouble(notional / config_.leverage);
+    if (mu.marginValue > common::Money {})
+        mu.marginLevel = common::Money::fromDouble(balance.toDouble() / mu.marginValue.toDouble() * 100.0);
+    mu.marginExcess = balance - mu.marginValue;
+    return mu;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "app_config.h"
+#include "common_types.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 按账户增量维护挂单敞口与保证金：每个订单事件只做一次哈希查找和整数加减，从不全量重算。
+// 账户按哈希分到固定数量的条带，每条带一把锁，不同分片线程更新不同账户时基本没有竞争。
+// 线程安全。
+class MarginEngine {
+public:
+    explicit MarginEngine(const MarginConfig& config = {});
+
+    // 订单开始挂单 / 离开挂单（撤单、改单）；敞口按未成交数量计
+    void onOrderOpened(const common::Order& order);
+    void onOrderClosed(const common::Order& order);
+    // 挂单成交：before/after 为成交前后的订单，after 全部成交时同时离开挂单
+    void onOrderFilled(const common::Order& before, const common::Order& after);
+
+    common::MarginUpdate marginOf(const std::string& account) const;
+    // 取出自上次调用以来有变化的账户，代价与变化的账户数成正比
+    std::vector<common::MarginUpdate> drainChanged();
+    std::size_t accountCount() const;
+
+private:
+    struct Account {
+        std::int64_t open_notional { 0 }; // 单位 1/kNotionalScale
+        std::uint32_t open_orders { 0 };
+        bool changed { false };
+    };
+
+    struct alignas(64) Stripe {
+        mutable std::mutex mtx;
+        std::unordered_map<std::string, Account> accounts;
+        std::vector<std::string> changed;
+    };
+
+    static constexpr std::size_t kStripes = 64;
+    static constexpr std::int64_t kNotionalScale = 10000;
+
+    static std::int64_t notionalOf(const common::Order& order);
+    Stripe& stripeOf(const std::string& account);
+    const Stripe& stripeOf(const std::string& account) const;
+    void apply(const std::string& account, std::int64_t notional, int orders);
+    common::MarginUpdate compute(const std::string& account, const Account& a) const;
+
+private:
+    MarginConfig config_;
+    std::array<Stripe, kStripes> stripes_;
+};
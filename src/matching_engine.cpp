@@ -0,0 +1,156 @@
+#include "matching_engine.h"
+
+#include <algorithm>
+
+OrderBook::Node* OrderBook::NodePool::acquire()
+{
+    if (free_) {
+        auto* node = free_;
+        free_ = node->next;
+        *node = Node {};
+        return node;
+    }
+    if (used_ == kBlockSize) {
+        blocks_.push_back(std::make_unique<Node[]>(kBlockSize));
+        used_ = 0;
+    }
+    return &blocks_.back()[used_++];
+}
+
+void OrderBook::NodePool::release(Node* node)
+{
+    node->next = free_;
+    free_ = node;
+}
+
+OrderBook::OrderBook()
+    : levels_ { Levels(&memory_), Levels(&memory_) }
+    , index_(&memory_)
+{
+}
+
+std::int64_t OrderBook::match(const BookOrderRequest& order, bool rest, std::vector<BookFill>& fills)
+{
+    auto side = sideOf(order.side);
+    auto& opposite = levels_[1 - side];
+    auto leaves = order.quantity;
+    while (leaves > 0 && !opposite.empty()) {
+        auto it = opposite.begin();
+        auto& level = it->second;
+        // 限价单只与不劣于自身价格的对手价成交
+        if (!order.market && (side == 0 ? level.price > order.price : level.price < order.price))
+            break;
+        while (leaves > 0 && level.head) {
+            auto* maker = level.head;
+            auto quantity = std::min(leaves, maker->leaves);
+            maker->leaves -= quantity;
+            level.quantity -= quantity;
+            leaves -= quantity;
+            fills.push_back({ maker->id, maker->owner, level.price, quantity, maker->leaves });
+            if (maker->leaves == 0) {
+                index_.erase(maker->id);
+                unlink(maker);
+                nodes_.release(maker);
+            }
+        }
+        if (!level.head)
+            opposite.erase(it);
+    }
+    if (leaves > 0 && rest && !order.market)
+        insert(side, order, leaves);
+    return leaves;
+}
+
+void OrderBook::add(const BookOrderRequest& order)
+{
+    if (order.quantity > 0)
+        insert(sideOf(order.side), order, order.quantity);
+}
+
+bool OrderBook::cancel(std::uint64_t id)
+{
+    auto it = index_.find(id);
+    if (it == index_.end())
+        return false;
+    auto* node = it->second;
+    index_.erase(it);
+    auto* level = node->level;
+    auto side = node->side;
+    unlink(node);
+    nodes_.release(node);
+    if (!level->head)
+        levels_[side].erase(keyOf(side, level->price));
+    return true;
+}
+
+std::optional<std::int64_t> OrderBook::bestBid() const
+{
+    if (levels_[0].empty())
+        return std::nullopt;
+    return levels_[0].begin()->second.price;
+}
+
+std::optional<std::int64_t> OrderBook::bestAsk() const
+{
+    if (levels_[1].empty())
+        return std::nullopt;
+    return levels_[1].begin()->second.price;
+}
+
+void OrderBook::insert(int side, const BookOrderRequest& order, std::int64_t quantity)
+{
+    auto [it, inserted] = levels_[side].try_emplace(keyOf(side, order.price));
+    auto& level = it->second;
+    if (inserted)
+        level.price = order.price;
+    auto* node = nodes_.acquire();
+    node->id = order.id;
+    node->owner = order.owner;
+    node->side = side;
+    node->leaves = quantity;
+    node->level = &level;
+    node->prev = level.tail;
+    if (level.tail)
+        level.tail->next = node;
+    else
+        level.head = node;
+    level.tail = node;
+    level.quantity += quantity;
+    index_.emplace(order.id, node);
+}
+
+void OrderBook::unlink(Node* node)
+{
+    auto* level = node->level;
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        level->head = node->next;
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        level->tail = node->prev;
+    level->quantity -= node->leaves;
+}
+
+std::int64_t MatchingEngine::submit(
+    const std::string& symbol, const BookOrderRequest& order, bool rest, std::vector<BookFill>& fills)
+{
+    auto& book = books_.get(symbol);
+    std::lock_guard<std::mutex> lk(book.mtx);
+    return book.book.match(order, rest, fills);
+}
+
+bool MatchingEngine::cancel(const std::string& symbol, std::uint64_t id)
+{
+    auto& book = books_.get(symbol);
+    std::lock_guard<std::mutex> lk(book.mtx);
+    return book.book.cancel(id);
+}
+
+void MatchingEngine::restore(const std::string& symbol, const BookOrderRequest& order)
+{
+    auto& book = books_.get(symbol);
+    std::lock_guard<std::mutex> lk(book.mtx);
+    book.book.add(order);
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "concurrent_registry.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 进入订单簿的订单，数量与价格为定点数；owner 由调用方解释（DomainService 中为分片下标）
+struct BookOrderRequest {
+    std::uint64_t id { 0 };
+    std::uint32_t owner { 0 };
+    char side { '1' }; // FIX Side (1=Buy,2=Sell)
+    bool market { false };
+    std::int64_t price { 0 };
+    std::int64_t quantity { 0 };
+};
+
+// 一笔成交：按被动方（簿内订单）的价格成交
+struct BookFill {
+    std::uint64_t maker_id { 0 };
+    std::uint32_t maker_owner { 0 };
+    std::int64_t price { 0 };
+    std::int64_t quantity { 0 };
+    std::int64_t maker_leaves { 0 }; // 成交后被动方的剩余数量
+};
+
+// 单个品种的限价订单簿，价格优先、时间优先。
+// 每个价位是簿内订单的侵入式双向链表（FIFO），订单节点来自按块分配、带空闲链表的节点池；
+// 价位表与撤单索引使用本订单簿独占的内存池，稳态下下单/成交/撤单不访问全局堆。
+// 价位表按键排序，买方的键为价格取负，两侧的首元素都是最优价。
+// 非线程安全，由调用方加锁。
+class OrderBook {
+public:
+    OrderBook();
+
+    OrderBook(const OrderBook&) = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
+
+    // 与对手方撮合，成交依次追加到 fills；rest 为 true 时限价单的剩余数量挂入订单簿。返回未成交数量
+    std::int64_t match(const BookOrderRequest& order, bool rest, std::vector<BookFill>& fills);
+    // 不撮合直接挂入队尾（启动恢复）
+    void add(const BookOrderRequest& order);
+    bool cancel(std::uint64_t id);
+
+    std::optional<std::int64_t> bestBid() const;
+    std::optional<std::int64_t> bestAsk() const;
+    std::size_t orderCount() const { return index_.size(); }
+    std::size_t levelCount() const { return levels_[0].size() + levels_[1].size(); }
+
+private:
+    struct Level;
+
+    struct Node {
+        std::uint64_t id { 0 };
+        std::uint32_t owner { 0 };
+        int side { 0 };
+        std::int64_t leaves { 0 };
+        Node* prev { nullptr };
+        Node* next { nullptr };
+        Level* level { nullptr };
+    };
+
+    struct Level {
+        std::int64_t price { 0 };
+        std::int64_t quantity { 0 }; // 价位上剩余数量合计
+        Node* head { nullptr };
+        Node* tail { nullptr };
+    };
+
+    // 按块分配节点，释放的节点进入空闲链表（复用 next 指针），节点地址在订单簿生命周期内不变
+    class NodePool {
+    public:
+        Node* acquire();
+        void release(Node* node);
+
+    private:
+        static constexpr std::size_t kBlockSize = 1024;
+        std::vector<std::unique_ptr<Node[]>> blocks_;
+        std::size_t used_ { kBlockSize }; // 最后一块中已分配的节点数
+        Node* free_ { nullptr };
+    };
+
+    using Levels = std::pmr::map<std::int64_t, Level>;
+
+    // 0 = 买方，1 = 卖方
+    static int sideOf(char side) { return side == '2' ? 1 : 0; }
+    static std::int64_t keyOf(int side, std::int64_t price) { return side == 0 ? -price : price; }
+    void insert(int side, const BookOrderRequest& order, std::int64_t quantity);
+    // 从价位链表中摘除节点，不删除空价位
+    void unlink(Node* node);
+
+private:
+    std::pmr::unsynchronized_pool_resource memory_;
+    Levels levels_[2];
+    std::pmr::unordered_map<std::uint64_t, Node*> index_;
+    NodePool nodes_;
+};
+
+// 每个品种一个订单簿、一把锁：不同品种的撮合互不阻塞，
+// 按账户分片时同一品种来自不同分片的订单在这把锁上串行化。
+// 线程安全。
+class MatchingEngine {
+public:
+    std::int64_t submit(
+        const std::string& symbol, const BookOrderRequest& order, bool rest, std::vector<BookFill>& fills);
+    // 订单已不在簿中（已全部成交或从未挂入）时返回 false
+    bool cancel(const std::string& symbol, std::uint64_t id);
+    void restore(const std::string& symbol, const BookOrderRequest& order);
+
+private:
+    struct Book {
+        std::mutex mtx;
+        OrderBook book;
+    };
+
+    ConcurrentRegistry<Book> books_;
+};
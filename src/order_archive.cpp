@@ -0,0 +1,135 @@
+#include "order_archive.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+constexpr std::size_t kInitialSlots = 1 << 16;
+
+} // namespace
+
+template <typename HashOf, typename Same>
+void OrderArchive::Index::insert(std::uint32_t record, HashOf&& hashOf, Same&& same)
+{
+    // 负载因子保持在 1/2 以下
+    if ((count_ + 1) * 2 > slots_.size())
+        grow(hashOf);
+    auto mask = slots_.size() - 1;
+    for (auto i = hashOf(record) & mask;; i = (i + 1) & mask) {
+        if (slots_[i] == 0) {
+            slots_[i] = record + 1;
+            ++count_;
+            return;
+        }
+        // 重复的键保留最早的记录
+        if (same(slots_[i] - 1))
+            return;
+    }
+}
+
+template <typename Same>
+std::optional<std::uint32_t> OrderArchive::Index::find(std::size_t hash, Same&& same) const
+{
+    if (slots_.empty())
+        return std::nullopt;
+    auto mask = slots_.size() - 1;
+    for (auto i = hash & mask; slots_[i] != 0; i = (i + 1) & mask) {
+        if (same(slots_[i] - 1))
+            return slots_[i] - 1;
+    }
+    return std::nullopt;
+}
+
+template <typename HashOf>
+void OrderArchive::Index::grow(HashOf&& hashOf)
+{
+    std::vector<std::uint32_t> old(std::max(kInitialSlots, slots_.size() * 2), 0);
+    old.swap(slots_);
+    auto mask = slots_.size() - 1;
+    for (auto slot : old) {
+        if (slot == 0)
+            continue;
+        auto i = hashOf(slot - 1) & mask;
+        while (slots_[i] != 0)
+            i = (i + 1) & mask;
+        slots_[i] = slot;
+    }
+}
+
+OrderArchive::OrderArchive(std::shared_ptr<const OrderStrings> strings)
+    : strings_(std::move(strings))
+{
+}
+
+void OrderArchive::append(const ArchivedOrder& record)
+{
+    auto index = static_cast<std::uint32_t>(records_.push(record));
+    auto key = clOrdKeyOf(index);
+    by_cl_ord_id_.insert(
+        index, [this](std::uint32_t i) { return ClOrdKeyHash {}(clOrdKeyOf(i)); },
+        [&](std::uint32_t i) { return clOrdKeyOf(i) == key; });
+    if (record.order_id.length != 0) {
+        auto orderId = orderIdOf(index);
+        by_order_id_.insert(
+            index, [this](std::uint32_t i) { return std::hash<std::string_view> {}(orderIdOf(i)); },
+            [&](std::uint32_t i) { return orderIdOf(i) == orderId; });
+    }
+}
+
+std::optional<std::size_t> OrderArchive::findByClOrdId(std::uint32_t session, std::string_view clOrdId) const
+{
+    ClOrdKey key { session, clOrdId };
+    return by_cl_ord_id_.find(ClOrdKeyHash {}(key), [&](std::uint32_t i) { return clOrdKeyOf(i) == key; });
+}
+
+std::optional<std::size_t> OrderArchive::findByOrderId(std::string_view orderId) const
+{
+    return by_order_id_.find(
+        std::hash<std::string_view> {}(orderId), [&](std::uint32_t i) { return orderIdOf(i) == orderId; });
+}
+
+common::Order OrderArchive::load(std::size_t index) const
+{
+    const auto& r = records_[index];
+    common::Order o;
+    o.orderId = strings_->ids.view(r.order_id);
+    o.clOrdId = strings_->ids.view(r.cl_ord_id);
+    o.symbol = strings_->names.name(r.symbol);
+    o.side = r.side;
+    o.quantity = common::fromFixed(r.quantity);
+    o.orderType = r.order_type;
+    o.price = common::fromFixed(r.price);
+    o.timeInForce = r.time_in_force;
+    o.account = strings_->names.name(r.account);
+    o.session = strings_->names.name(r.session);
+    o.status = common::toString(r.state);
+    o.cumQty = common::fromFixed(r.cum_qty);
+    o.avgPx = common::fromFixed(r.avg_px);
+    return o;
+}
+
+OrderRecordView OrderArchive::view(std::size_t index) const
+{
+    const auto& r = records_[index];
+    OrderRecordView v;
+    v.cl_ord_id = strings_->ids.view(r.cl_ord_id);
+    v.order_id = strings_->ids.view(r.order_id);
+    v.symbol = strings_->names.name(r.symbol);
+    v.account = strings_->names.name(r.account);
+    v.session = strings_->names.name(r.session);
+    v.quantity = r.quantity;
+    v.price = r.price;
+    v.side = r.side;
+    v.order_type = r.order_type;
+    v.time_in_force = r.time_in_force;
+    v.state = r.state;
+    v.cum_qty = r.cum_qty;
+    v.avg_px = r.avg_px;
+    return v;
+}
+
+std::size_t OrderArchive::memoryBytes() const
+{
+    return records_.size() * sizeof(ArchivedOrder) + by_cl_ord_id_.memoryBytes() + by_order_id_.memoryBytes();
+}
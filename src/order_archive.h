@@ -0,0 +1,79 @@
+#pragma once
+
+#include "common_types.h"
+#include "order_chunk.h"
+#include "string_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// 冷存储中的紧凑订单记录（仅终态订单），每条 72 字节，文本仍引用 OrderStrings
+struct ArchivedOrder {
+    TextRef cl_ord_id;
+    TextRef order_id;
+    std::uint32_t symbol { 0 };
+    std::uint32_t account { 0 };
+    std::uint32_t session { 0 };
+    std::int64_t quantity { 0 };
+    std::int64_t price { 0 };
+    std::int64_t cum_qty { 0 };
+    std::int64_t avg_px { 0 };
+    char side { '1' };
+    char order_type { '1' };
+    char time_in_force { '0' };
+    common::OrderState state { common::OrderState::New };
+};
+static_assert(sizeof(ArchivedOrder) == 72, "ArchivedOrder: layout changed, update the size above");
+
+// 终态订单的只追加冷存储。记录写入后不再修改，读者可无锁读取下标 < size() 的记录；
+// 按 (会话, ClOrdID)/OrderID 的查找使用开放寻址的紧凑索引（每个键 4 字节槽位），只能在写者上下文中调用。
+class OrderArchive {
+public:
+    explicit OrderArchive(std::shared_ptr<const OrderStrings> strings);
+
+    void append(const ArchivedOrder& record);
+
+    // session 为 OrderStrings::names 中的 id
+    std::optional<std::size_t> findByClOrdId(std::uint32_t session, std::string_view clOrdId) const;
+    std::optional<std::size_t> findByOrderId(std::string_view orderId) const;
+
+    // 线程安全
+    common::Order load(std::size_t index) const;
+    OrderRecordView view(std::size_t index) const;
+    const ArchivedOrder& record(std::size_t index) const { return records_[index]; }
+    std::size_t size() const { return records_.size(); }
+    std::size_t memoryBytes() const;
+
+private:
+    // 线性探测哈希表，槽位存放记录下标 + 1（0 表示空），不保存键：
+    // hashOf(i) 为记录 i 的键的哈希，same(i) 判断记录 i 的键是否与要插入/查找的键相同
+    class Index {
+    public:
+        template <typename HashOf, typename Same>
+        void insert(std::uint32_t record, HashOf&& hashOf, Same&& same);
+        template <typename Same>
+        std::optional<std::uint32_t> find(std::size_t hash, Same&& same) const;
+        std::size_t memoryBytes() const { return slots_.capacity() * sizeof(std::uint32_t); }
+
+    private:
+        template <typename HashOf>
+        void grow(HashOf&& hashOf);
+
+        std::vector<std::uint32_t> slots_;
+        std::size_t count_ { 0 };
+    };
+
+    std::string_view clOrdIdOf(std::uint32_t index) const { return strings_->ids.view(records_[index].cl_ord_id); }
+    std::string_view orderIdOf(std::uint32_t index) const { return strings_->ids.view(records_[index].order_id); }
+    ClOrdKey clOrdKeyOf(std::uint32_t index) const { return { records_[index].session, clOrdIdOf(index) }; }
+
+private:
+    std::shared_ptr<const OrderStrings> strings_;
+    AppendOnlyVector<ArchivedOrder, 16384, 16384> records_;
+    Index by_cl_ord_id_;
+    Index by_order_id_;
+};
@@ -0,0 +1,76 @@
+#include "order_chunk.h"
+
+OrderRecordView OrderRecordView::of(const common::Order& order)
+{
+    OrderRecordView v;
+    v.cl_ord_id = order.clOrdId;
+    v.order_id = order.orderId;
+    v.symbol = order.symbol;
+    v.account = order.account;
+    v.session = order.session;
+    v.quantity = common::toFixed(order.quantity);
+    v.price = common::toFixed(order.price);
+    v.side = order.side;
+    v.order_type = order.orderType;
+    v.time_in_force = order.timeInForce;
+    v.state = common::parseOrderState(order.status);
+    v.cum_qty = common::toFixed(order.cumQty);
+    v.avg_px = common::toFixed(order.avgPx);
+    return v;
+}
+
+void OrderChunk::store(std::size_t slot, const OrderRecordView& order, OrderStrings& strings)
+{
+    cl_ord_id[slot] = strings.ids.append(order.cl_ord_id);
+    order_id[slot] = strings.ids.append(order.order_id);
+    symbol[slot] = strings.names.intern(order.symbol);
+    account[slot] = strings.names.intern(order.account);
+    session[slot] = strings.names.intern(order.session);
+    quantity[slot] = order.quantity;
+    price[slot] = order.price;
+    side[slot] = order.side;
+    order_type[slot] = order.order_type;
+    time_in_force[slot] = order.time_in_force;
+    state[slot] = order.state;
+    cum_qty[slot] = order.cum_qty;
+    avg_px[slot] = order.avg_px;
+    live[slot] = true;
+}
+
+OrderRecordView OrderChunk::view(std::size_t slot, const OrderStrings& strings) const
+{
+    OrderRecordView v;
+    v.cl_ord_id = strings.ids.view(cl_ord_id[slot]);
+    v.order_id = strings.ids.view(order_id[slot]);
+    v.symbol = strings.names.name(symbol[slot]);
+    v.account = strings.names.name(account[slot]);
+    v.session = strings.names.name(session[slot]);
+    v.quantity = quantity[slot];
+    v.price = price[slot];
+    v.side = side[slot];
+    v.order_type = order_type[slot];
+    v.time_in_force = time_in_force[slot];
+    v.state = state[slot];
+    v.cum_qty = cum_qty[slot];
+    v.avg_px = avg_px[slot];
+    return v;
+}
+
+common::Order OrderChunk::load(std::size_t slot, const OrderStrings& strings) const
+{
+    common::Order o;
+    o.orderId = strings.ids.view(order_id[slot]);
+    o.clOrdId = strings.ids.view(cl_ord_id[slot]);
+    o.symbol = strings.names.name(symbol[slot]);
+    o.side = side[slot];
+    o.quantity = common::fromFixed(quantity[slot]);
+    o.orderType = order_type[slot];
+    o.price = common::fromFixed(price[slot]);
+    o.timeInForce = time_in_force[slot];
+    o.account = strings.names.name(account[slot]);
+    o.session = strings.names.name(session[slot]);
+    o.status = common::toString(state[slot]);
+    o.cumQty = common::fromFixed(cum_qty[slot]);
+    o.avgPx = common::fromFixed(avg_px[slot]);
+    return o;
+}
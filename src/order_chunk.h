@@ -0,0 +1,78 @@
+#pragma once
+
+#include "common_types.h"
+#include "string_pool.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+// 订单相关的文本存储：ClOrdID/OrderID 放在文本区，品种、账户与会话驻留为整数 id。
+// 只追加，被存储与各快照共享。
+struct OrderStrings {
+    TextArena ids;
+    InternTable names;
+};
+
+// ClOrdID 只在下单会话内唯一，按 (会话, ClOrdID) 定位订单
+struct ClOrdKey {
+    std::uint32_t session { 0 }; // OrderStrings::names 中的 id
+    std::string_view cl_ord_id;
+
+    bool operator==(const ClOrdKey&) const = default;
+};
+
+struct ClOrdKeyHash {
+    std::size_t operator()(const ClOrdKey& key) const
+    {
+        return std::hash<std::string_view> {}(key.cl_ord_id) ^ (key.session * std::size_t { 0x9E3779B97F4A7C15 });
+    }
+};
+
+// 不持有内存的订单记录视图，文本指向文本区/映射文件等外部存储；
+// 用于日志回放与快照落盘，避免逐字段还原 std::string
+struct OrderRecordView {
+    std::string_view cl_ord_id;
+    std::string_view order_id;
+    std::string_view symbol;
+    std::string_view account;
+    std::string_view session;
+    std::int64_t quantity { 0 }; // 定点数，见 common::kFixedScale
+    std::int64_t price { 0 };
+    char side { '1' };
+    char order_type { '1' };
+    char time_in_force { '0' };
+    common::OrderState state { common::OrderState::New };
+    std::int64_t cum_qty { 0 }; // 定点数
+    std::int64_t avg_px { 0 };
+
+    static OrderRecordView of(const common::Order& order);
+};
+
+// 列式（SoA）订单块：每列一个定长数组，扫描某一列时不必加载其他字段。
+// 块被快照引用后即视为只读，写入方改写前先复制（写时复制）。
+struct OrderChunk {
+    static constexpr std::size_t kCapacity = 256;
+
+    std::array<TextRef, kCapacity> cl_ord_id;
+    std::array<TextRef, kCapacity> order_id;
+    std::array<std::uint32_t, kCapacity> symbol;
+    std::array<std::uint32_t, kCapacity> account;
+    std::array<std::uint32_t, kCapacity> session;
+    std::array<std::int64_t, kCapacity> quantity; // 定点数，见 common::kFixedScale
+    std::array<std::int64_t, kCapacity> price;
+    std::array<char, kCapacity> side;
+    std::array<char, kCapacity> order_type;
+    std::array<char, kCapacity> time_in_force;
+    std::array<common::OrderState, kCapacity> state;
+    std::array<std::int64_t, kCapacity> cum_qty; // 定点数
+    std::array<std::int64_t, kCapacity> avg_px;
+    std::array<bool, kCapacity> live {}; // 槽位被淘汰到冷存储后置为 false，可被新订单复用
+
+    void store(std::size_t slot, const OrderRecordView& order, OrderStrings& strings);
+    OrderRecordView view(std::size_t slot, const OrderStrings& strings) const;
+    // 还原为边界类型 common::Order
+    common::Order load(std::size_t slot, const OrderStrings& strings) const;
+};
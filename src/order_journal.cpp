@@ -0,0 +1,552 @@
+#include "order_journal.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bip = boost::interprocess;
+
+namespace {
+
+// 002：Insert 记录带累计成交量/均价，新增 Fill 记录；003：Insert 记录带下单会话；
+// 004：State/Fill 记录按 OrderID 定位订单（ClOrdID 只在会话内唯一）
+constexpr std::uint64_t kSegmentMagic = 0x3430304C4E4A4142ull; // "BAJNL004"
+constexpr std::uint64_t kSnapshotMagic = 0x33305053414E5342ull; // "BSNAPS03"
+constexpr std::size_t kSegmentHeaderBytes = 16; // magic u64, shard u32, reserved u32
+constexpr std::size_t kSnapshotHeaderBytes = 40; // magic, seq, inserts, count, reserved (u64)
+constexpr std::size_t kRecordHeaderBytes = 16; // size u32, checksum u32, seq u64
+constexpr std::size_t kMinSegmentBytes = 1 << 20;
+
+enum class RecordType : std::uint8_t { Insert = 1, State = 2, Fill = 3 };
+
+std::size_t align8(std::size_t n) { return (n + 7) & ~static_cast<std::size_t>(7); }
+
+std::uint32_t checksum(const char* data, std::size_t n)
+{
+    // FNV-1a
+    std::uint32_t h = 2166136261u;
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+class Encoder {
+public:
+    explicit Encoder(char* p)
+        : p_(p)
+    {
+    }
+
+    template <typename T>
+    void put(T v)
+    {
+        std::memcpy(p_, &v, sizeof(T));
+        p_ += sizeof(T);
+    }
+
+    void putText(std::string_view s)
+    {
+        put(static_cast<std::uint16_t>(s.size()));
+        std::memcpy(p_, s.data(), s.size());
+        p_ += s.size();
+    }
+
+private:
+    char* p_;
+};
+
+class Decoder {
+public:
+    Decoder(const char* p, std::size_t n)
+        : p_(p)
+        , end_(p + n)
+    {
+    }
+
+    template <typename T>
+    bool get(T& v)
+    {
+        if (static_cast<std::size_t>(end_ - p_) < sizeof(T))
+            return false;
+        std::memcpy(&v, p_, sizeof(T));
+        p_ += sizeof(T);
+        return true;
+    }
+
+    bool getText(std::string_view& s)
+    {
+        std::uint16_t n = 0;
+        if (!get(n) || static_cast<std::size_t>(end_ - p_) < n)
+            return false;
+        s = { p_, n };
+        p_ += n;
+        return true;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+void checkTextLength(std::string_view s)
+{
+    if (s.size() > 0xFFFF)
+        throw std::length_error("OrderJournal: text field too long");
+}
+
+std::size_t insertPayloadBytes(const OrderRecordView& o)
+{
+    return 5 + 4 * sizeof(std::int64_t) + 5 * sizeof(std::uint16_t) + o.cl_ord_id.size() + o.order_id.size()
+        + o.symbol.size() + o.account.size() + o.session.size();
+}
+
+void encodeInsert(char* p, const OrderRecordView& o)
+{
+    Encoder e(p);
+    e.put(static_cast<std::uint8_t>(RecordType::Insert));
+    e.put(static_cast<std::uint8_t>(o.state));
+    e.put(o.side);
+    e.put(o.order_type);
+    e.put(o.time_in_force);
+    e.put(o.quantity);
+    e.put(o.price);
+    e.put(o.cum_qty);
+    e.put(o.avg_px);
+    e.putText(o.cl_ord_id);
+    e.putText(o.order_id);
+    e.putText(o.symbol);
+    e.putText(o.account);
+    e.putText(o.session);
+}
+
+bool decodePayload(const char* p, std::size_t n, const OrderJournal::InsertHandler& on_insert,
+    const OrderJournal::StateHandler& on_state, const OrderJournal::FillHandler& on_fill)
+{
+    Decoder d(p, n);
+    std::uint8_t type = 0;
+    std::uint8_t state = 0;
+    if (!d.get(type) || !d.get(state))
+        return false;
+    if (type == static_cast<std::uint8_t>(RecordType::Insert)) {
+        OrderRecordView o;
+        o.state = static_cast<common::OrderState>(state);
+        if (!d.get(o.side) || !d.get(o.order_type) || !d.get(o.time_in_force) || !d.get(o.quantity)
+            || !d.get(o.price) || !d.get(o.cum_qty) || !d.get(o.avg_px) || !d.getText(o.cl_ord_id)
+            || !d.getText(o.order_id) || !d.getText(o.symbol) || !d.getText(o.account) || !d.getText(o.session))
+            return false;
+        on_insert(o);
+        return true;
+    }
+    if (type == static_cast<std::uint8_t>(RecordType::State)) {
+        std::string_view orderId;
+        if (!d.getText(orderId))
+            return false;
+        on_state(orderId, static_cast<common::OrderState>(state));
+        return true;
+    }
+    if (type == static_cast<std::uint8_t>(RecordType::Fill)) {
+        std::int64_t cum_qty = 0;
+        std::int64_t avg_px = 0;
+        std::string_view orderId;
+        if (!d.get(cum_qty) || !d.get(avg_px) || !d.getText(orderId))
+            return false;
+        on_fill(orderId, static_cast<common::OrderState>(state), cum_qty, avg_px);
+        return true;
+    }
+    return false;
+}
+
+// 写入记录头（调用方已将填充字节清零）；size 最后写入，使未写完的记录在回放时表现为结束标记
+void sealRecord(char* p, std::size_t total, std::uint64_t seq)
+{
+    auto sum = checksum(p + kRecordHeaderBytes, total - kRecordHeaderBytes);
+    std::memcpy(p + 4, &sum, sizeof(sum));
+    std::memcpy(p + 8, &seq, sizeof(seq));
+    auto size = static_cast<std::uint32_t>(total);
+    std::memcpy(p, &size, sizeof(size));
+}
+
+// 依次解析 [offset, size) 中的记录；返回解析停止的位置，torn 表示遇到了损坏的记录
+template <typename Fn>
+std::size_t scanRecords(const char* data, std::size_t size, std::size_t offset, bool& torn, Fn&& fn)
+{
+    torn = false;
+    while (offset + kRecordHeaderBytes <= size) {
+        std::uint32_t rec_size = 0;
+        std::uint32_t sum = 0;
+        std::uint64_t seq = 0;
+        std::memcpy(&rec_size, data + offset, sizeof(rec_size));
+        if (rec_size == 0)
+            break;
+        if (rec_size < kRecordHeaderBytes || rec_size > size - offset) {
+            torn = true;
+            break;
+        }
+        std::memcpy(&sum, data + offset + 4, sizeof(sum));
+        std::memcpy(&seq, data + offset + 8, sizeof(seq));
+        const char* payload = data + offset + kRecordHeaderBytes;
+        auto payload_bytes = rec_size - kRecordHeaderBytes;
+        if (checksum(payload, payload_bytes) != sum || !fn(seq, payload, payload_bytes)) {
+            torn = true;
+            break;
+        }
+        offset += rec_size;
+    }
+    return offset;
+}
+
+void createFile(const std::filesystem::path& path, std::size_t bytes)
+{
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        if (!f)
+            throw std::runtime_error("OrderJournal: cannot create " + path.string());
+    }
+    std::filesystem::resize_file(path, bytes);
+}
+
+} // namespace
+
+OrderJournal::OrderJournal(std::filesystem::path dir, std::size_t shard, std::size_t segment_bytes)
+    : dir_(std::move(dir))
+    , shard_(shard)
+    , segment_bytes_(std::max(segment_bytes, kMinSegmentBytes))
+{
+    std::filesystem::create_directories(dir_);
+}
+
+OrderJournal::~OrderJournal()
+{
+    std::lock_guard<std::mutex> lk(segment_mtx_);
+    closeSegment();
+}
+
+std::size_t OrderJournal::shardCount(const std::filesystem::path& dir)
+{
+    std::size_t count = 0;
+    if (!std::filesystem::exists(dir))
+        return count;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        auto name = entry.path().filename().string();
+        unsigned long long shard = 0;
+        if (name.rfind("orders-", 0) == 0 && std::sscanf(name.c_str(), "orders-%llu", &shard) == 1)
+            count = std::max<std::size_t>(count, shard + 1);
+    }
+    return count;
+}
+
+std::string OrderJournal::readLayout(const std::filesystem::path& dir)
+{
+    std::ifstream in(dir / "layout");
+    std::string layout;
+    std::getline(in, layout);
+    return layout;
+}
+
+void OrderJournal::writeLayout(const std::filesystem::path& dir, const std::string& layout)
+{
+    // 先写临时文件再改名，不会留下半个布局文件
+    auto tmp = dir / "layout.tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        out << layout << '\n';
+        if (!out.flush())
+            throw std::runtime_error("OrderJournal: cannot write " + tmp.string());
+    }
+    std::filesystem::rename(tmp, dir / "layout");
+}
+
+JournalRecoveryStats OrderJournal::recover(
+    const InsertHandler& on_insert, const StateHandler& on_state, const FillHandler& on_fill)
+{
+    JournalRecoveryStats stats;
+    std::uint64_t base_seq = 0;
+
+    auto snap_path = snapshotPath();
+    if (std::filesystem::exists(snap_path) && std::filesystem::file_size(snap_path) >= kSnapshotHeaderBytes) {
+        bip::file_mapping file(snap_path.string().c_str(), bip::read_only);
+        bip::mapped_region region(file, bip::read_only);
+        const char* data = static_cast<const char*>(region.get_address());
+        Decoder header(data, kSnapshotHeaderBytes);
+        std::uint64_t magic = 0;
+        std::uint64_t count = 0;
+        header.get(magic);
+        header.get(base_seq);
+        header.get(stats.position.inserts);
+        header.get(count);
+        if (magic != kSnapshotMagic)
+            throw std::runtime_error("OrderJournal: bad snapshot file " + snap_path.string());
+        bool torn = false;
+        scanRecords(data, region.get_size(), kSnapshotHeaderBytes, torn,
+            [&](std::uint64_t, const char* p, std::size_t n) {
+                if (!decodePayload(p, n, on_insert, on_state, on_fill))
+                    return false;
+                ++stats.snapshot_orders;
+                return true;
+            });
+        if (torn || stats.snapshot_orders != count)
+            throw std::runtime_error("OrderJournal: corrupted snapshot file " + snap_path.string());
+    }
+    stats.position.seq = base_seq;
+
+    std::vector<std::pair<std::uint64_t, std::filesystem::path>> segments;
+    auto prefix = "orders-" + std::to_string(shard_) + "-";
+    for (const auto& entry : std::filesystem::directory_iterator(dir_)) {
+        auto name = entry.path().filename().string();
+        if (name.rfind(prefix, 0) != 0 || entry.path().extension() != ".jnl")
+            continue;
+        auto first_seq = std::stoull(name.substr(prefix.size(), name.size() - prefix.size() - 4));
+        segments.emplace_back(first_seq, entry.path());
+    }
+    std::sort(segments.begin(), segments.end());
+
+    for (const auto& [first_seq, path] : segments) {
+        if (std::filesystem::file_size(path) < kSegmentHeaderBytes)
+            continue;
+        bip::file_mapping file(path.string().c_str(), bip::read_only);
+        bip::mapped_region region(file, bip::read_only);
+        const char* data = static_cast<const char*>(region.get_address());
+        std::uint64_t magic = 0;
+        std::memcpy(&magic, data, sizeof(magic));
+        if (magic != kSegmentMagic) {
+            SPDLOG_WARN("Journal segment {} has a bad header, skipped", path.string());
+            continue;
+        }
+        bool torn = false;
+        auto end = scanRecords(data, region.get_size(), kSegmentHeaderBytes, torn,
+            [&](std::uint64_t seq, const char* p, std::size_t n) {
+                if (seq <= base_seq)
+                    return true;
+                std::uint8_t type = 0;
+                std::memcpy(&type, p, sizeof(type));
+                if (!decodePayload(p, n, on_insert, on_state, on_fill))
+                    return false;
+                if (type == static_cast<std::uint8_t>(RecordType::Insert)) {
+                    ++stats.replayed_inserts;
+                    ++stats.position.inserts;
+                } else {
+                    ++stats.replayed_states;
+                }
+                stats.position.seq = std::max(stats.position.seq, seq);
+                return true;
+            });
+        if (torn)
+            SPDLOG_WARN("Journal segment {} is truncated at offset {}", path.string(), end);
+    }
+
+    next_seq_ = stats.position.seq + 1;
+    inserts_ = stats.position.inserts;
+    return stats;
+}
+
+void OrderJournal::open()
+{
+    std::lock_guard<std::mutex> lk(segment_mtx_);
+    if (!segment_)
+        openSegment(next_seq_);
+}
+
+void OrderJournal::appendInsert(const OrderRecordView& order)
+{
+    checkTextLength(order.cl_ord_id);
+    checkTextLength(order.order_id);
+    checkTextLength(order.symbol);
+    checkTextLength(order.account);
+    checkTextLength(order.session);
+    auto total = align8(kRecordHeaderBytes + insertPayloadBytes(order));
+    char* p = reserve(total);
+    std::memset(p, 0, total);
+    encodeInsert(p + kRecordHeaderBytes, order);
+    sealRecord(p, total, next_seq_++);
+    commit(total);
+    ++inserts_;
+}
+
+void OrderJournal::appendState(std::string_view orderId, common::OrderState state)
+{
+    checkTextLength(orderId);
+    auto total = align8(kRecordHeaderBytes + 2 + sizeof(std::uint16_t) + orderId.size());
+    char* p = reserve(total);
+    std::memset(p, 0, total);
+    Encoder e(p + kRecordHeaderBytes);
+    e.put(static_cast<std::uint8_t>(RecordType::State));
+    e.put(static_cast<std::uint8_t>(state));
+    e.putText(orderId);
+    sealRecord(p, total, next_seq_++);
+    commit(total);
+}
+
+void OrderJournal::appendFill(
+    std::string_view orderId, common::OrderState state, std::int64_t cum_qty, std::int64_t avg_px)
+{
+    checkTextLength(orderId);
+    auto total = align8(kRecordHeaderBytes + 2 + 2 * sizeof(std::int64_t) + sizeof(std::uint16_t) + orderId.size());
+    char* p = reserve(total);
+    std::memset(p, 0, total);
+    Encoder e(p + kRecordHeaderBytes);
+    e.put(static_cast<std::uint8_t>(RecordType::Fill));
+    e.put(static_cast<std::uint8_t>(state));
+    e.put(cum_qty);
+    e.put(avg_px);
+    e.putText(orderId);
+    sealRecord(p, total, next_seq_++);
+    commit(total);
+}
+
+void OrderJournal::flush()
+{
+    std::lock_guard<std::mutex> lk(segment_mtx_);
+    if (!segment_)
+        return;
+    auto written = written_.load(std::memory_order_acquire);
+    if (written <= flushed_)
+        return;
+    // msync 要求起始地址按页对齐
+    auto page = bip::mapped_region::get_page_size();
+    auto start = flushed_ / page * page;
+    if (!segment_->region.flush(start, written - start, false))
+        SPDLOG_ERROR("Journal flush failed: {}", segment_->path.string());
+    flushed_ = written;
+}
+
+JournalPosition OrderJournal::rollForSnapshot()
+{
+    JournalPosition position { next_seq_ - 1, inserts_ };
+    if (write_off_ > kSegmentHeaderBytes) {
+        std::lock_guard<std::mutex> lk(segment_mtx_);
+        closeSegment();
+        openSegment(next_seq_);
+    }
+    return position;
+}
+
+void OrderJournal::writeSnapshot(const OrderSnapshot& snapshot, const JournalPosition& position)
+{
+    std::size_t total = kSnapshotHeaderBytes;
+    std::uint64_t count = 0;
+    snapshot.forEachRecord([&](const OrderRecordView& o) {
+        total += align8(kRecordHeaderBytes + insertPayloadBytes(o));
+        ++count;
+    });
+
+    auto path = snapshotPath();
+    auto tmp = path;
+    tmp += ".tmp";
+    createFile(tmp, total);
+    {
+        bip::file_mapping file(tmp.string().c_str(), bip::read_write);
+        bip::mapped_region region(file, bip::read_write);
+        char* data = static_cast<char*>(region.get_address());
+        Encoder header(data);
+        header.put(kSnapshotMagic);
+        header.put(position.seq);
+        header.put(position.inserts);
+        header.put(count);
+        header.put(std::uint64_t { 0 });
+        std::size_t off = kSnapshotHeaderBytes;
+        snapshot.forEachRecord([&](const OrderRecordView& o) {
+            auto bytes = align8(kRecordHeaderBytes + insertPayloadBytes(o));
+            encodeInsert(data + off + kRecordHeaderBytes, o);
+            sealRecord(data + off, bytes, 0);
+            off += bytes;
+        });
+        if (!region.flush(0, 0, false))
+            throw std::runtime_error("OrderJournal: snapshot flush failed " + tmp.string());
+    }
+    std::filesystem::rename(tmp, path);
+    removeSegmentsBefore(position.seq);
+    SPDLOG_INFO(
+        "Journal snapshot written: shard={}, orders={}, seq={}, bytes={}", shard_, count, position.seq, total);
+}
+
+std::filesystem::path OrderJournal::segmentPath(std::uint64_t first_seq) const
+{
+    char name[64];
+    std::snprintf(name, sizeof(name), "orders-%zu-%020llu.jnl", shard_, static_cast<unsigned long long>(first_seq));
+    return dir_ / name;
+}
+
+std::filesystem::path OrderJournal::snapshotPath() const
+{
+    return dir_ / ("orders-" + std::to_string(shard_) + ".snap");
+}
+
+void OrderJournal::openSegment(std::uint64_t first_seq)
+{
+    auto seg = std::make_unique<Segment>();
+    seg->first_seq = first_seq;
+    seg->path = segmentPath(first_seq);
+    createFile(seg->path, segment_bytes_);
+    seg->file = bip::file_mapping(seg->path.string().c_str(), bip::read_write);
+    seg->region = bip::mapped_region(seg->file, bip::read_write);
+    base_ = static_cast<char*>(seg->region.get_address());
+    Encoder header(base_);
+    header.put(kSegmentMagic);
+    header.put(static_cast<std::uint32_t>(shard_));
+    header.put(std::uint32_t { 0 });
+    segment_ = std::move(seg);
+    write_off_ = kSegmentHeaderBytes;
+    written_.store(write_off_, std::memory_order_release);
+    flushed_ = 0;
+}
+
+void OrderJournal::closeSegment()
+{
+    if (!segment_)
+        return;
+    auto written = written_.load(std::memory_order_acquire);
+    segment_->region.flush(0, 0, false);
+    auto path = segment_->path;
+    segment_.reset();
+    base_ = nullptr;
+    // 解除映射后截掉预分配但未使用的尾部
+    std::error_code ec;
+    std::filesystem::resize_file(path, written, ec);
+}
+
+char* OrderJournal::reserve(std::size_t bytes)
+{
+    if (!segment_ || write_off_ + bytes > segment_bytes_) {
+        std::lock_guard<std::mutex> lk(segment_mtx_);
+        closeSegment();
+        openSegment(next_seq_);
+    }
+    return base_ + write_off_;
+}
+
+void OrderJournal::commit(std::size_t bytes)
+{
+    write_off_ += bytes;
+    written_.store(write_off_, std::memory_order_release);
+}
+
+void OrderJournal::removeSegmentsBefore(std::uint64_t seq)
+{
+    std::filesystem::path active;
+    {
+        std::lock_guard<std::mutex> lk(segment_mtx_);
+        if (segment_)
+            active = segment_->path;
+    }
+    auto prefix = "orders-" + std::to_string(shard_) + "-";
+    for (const auto& entry : std::filesystem::directory_iterator(dir_)) {
+        auto name = entry.path().filename().string();
+        if (name.rfind(prefix, 0) != 0 || entry.path().extension() != ".jnl" || entry.path() == active)
+            continue;
+        // 起始序号 <= seq 的日志段在切换时已封口，其中的记录全部被快照覆盖
+        auto first_seq = std::stoull(name.substr(prefix.size(), name.size() - prefix.size() - 4));
+        if (first_seq <= seq) {
+            std::error_code ec;
+            std::filesystem::remove(entry.path(), ec);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "common_types.h"
+#include "order_chunk.h"
+#include "order_snapshot.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// 日志位置：分片累计写入的记录数（即最后一条记录的序号）及其中的 Insert 记录数。
+// 每条记录恰好对应一个 ExecID，每条 Insert 对应一个 OrderID，恢复后据此续接序号
+struct JournalPosition {
+    std::uint64_t seq { 0 };
+    std::uint64_t inserts { 0 };
+};
+
+struct JournalRecoveryStats {
+    JournalPosition position;
+    std::size_t snapshot_orders { 0 };
+    std::size_t replayed_inserts { 0 };
+    std::size_t replayed_states { 0 };
+};
+
+// 单个分片的只追加订单日志：分段的内存映射文件 + 周期性紧凑快照。
+//   - append*() 只能由分片的写者调用，直接写入映射内存，不做系统调用；
+//   - flush() 由后台线程周期调用，把一段时间内的所有追加一起落盘（group commit）；
+//   - 快照：写者上下文中调用 rollForSnapshot() 切换日志段并确定快照序号，
+//     之后可在任意线程调用 writeSnapshot()，完成后删除已被快照覆盖的日志段；
+//   - 启动时 recover() 先加载最新快照，再只回放序号大于快照序号的日志尾部。
+// 记录按小端序编码，每条记录带长度与校验和，回放遇到撕裂/损坏的记录即停止。
+class OrderJournal {
+public:
+    using InsertHandler = std::function<void(const OrderRecordView&)>;
+    // 状态与成交记录按 OrderID 定位订单
+    using StateHandler = std::function<void(std::string_view orderId, common::OrderState state)>;
+    using FillHandler = std::function<void(
+        std::string_view orderId, common::OrderState state, std::int64_t cum_qty, std::int64_t avg_px)>;
+
+    OrderJournal(std::filesystem::path dir, std::size_t shard, std::size_t segment_bytes);
+    ~OrderJournal();
+
+    OrderJournal(const OrderJournal&) = delete;
+    OrderJournal& operator=(const OrderJournal&) = delete;
+
+    // 目录中已有日志文件的分片数（最大分片编号 + 1）
+    static std::size_t shardCount(const std::filesystem::path& dir);
+    // 写日志时的分片布局（分片数与路由键），每个分片的日志只能回放到同一个分片；未记录过时返回空串
+    static std::string readLayout(const std::filesystem::path& dir);
+    static void writeLayout(const std::filesystem::path& dir, const std::string& layout);
+
+    JournalRecoveryStats recover(
+        const InsertHandler& on_insert, const StateHandler& on_state, const FillHandler& on_fill);
+    // 在 recover() 之后调用：新建日志段，序号从最后一条记录之后继续
+    void open();
+
+    void appendInsert(const OrderRecordView& order);
+    void appendState(std::string_view orderId, common::OrderState state);
+    // 成交：累计成交量与均价为定点数
+    void appendFill(std::string_view orderId, common::OrderState state, std::int64_t cum_qty, std::int64_t avg_px);
+
+    // 线程安全：把已追加但尚未落盘的数据同步到磁盘
+    void flush();
+
+    // 写者上下文：切换到新日志段，返回快照应覆盖到的位置
+    JournalPosition rollForSnapshot();
+    void writeSnapshot(const OrderSnapshot& snapshot, const JournalPosition& position);
+
+private:
+    struct Segment {
+        std::uint64_t first_seq { 0 };
+        std::filesystem::path path;
+        boost::interprocess::file_mapping file;
+        boost::interprocess::mapped_region region;
+    };
+
+    std::filesystem::path segmentPath(std::uint64_t first_seq) const;
+    std::filesystem::path snapshotPath() const;
+    void openSegment(std::uint64_t first_seq);
+    void closeSegment();
+    char* reserve(std::size_t bytes);
+    void commit(std::size_t bytes);
+    void removeSegmentsBefore(std::uint64_t seq);
+
+private:
+    std::filesystem::path dir_;
+    std::size_t shard_ { 0 };
+    std::size_t segment_bytes_ { 0 };
+
+    std::unique_ptr<Segment> segment_;
+    char* base_ { nullptr };
+    std::size_t write_off_ { 0 };
+    std::uint64_t next_seq_ { 1 };
+    std::uint64_t inserts_ { 0 };
+
+    // flush 与切换日志段互斥；追加路径不加锁
+    std::mutex segment_mtx_;
+    std::atomic<std::size_t> written_ { 0 };
+    std::size_t flushed_ { 0 };
+};
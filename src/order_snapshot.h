@@ -0,0 +1,168 @@
+#pragma once
+
+#include "common_types.h"
+#include "order_archive.h"
+#include "order_chunk.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// 快照/视图上的过滤条件，未设置的字段不参与过滤
+struct OrderFilter {
+    std::optional<common::OrderState> state;
+    std::optional<std::string> account;
+};
+
+// 单个 OrderStore 在某一版本上的只读快照（含冷存储），与存储共享未被修改的块，读取时不持有任何锁
+class OrderSnapshot {
+public:
+    OrderSnapshot(std::vector<std::shared_ptr<const OrderChunk>> chunks, std::shared_ptr<const OrderStrings> strings,
+        std::size_t hot_slots, std::size_t hot_orders, std::shared_ptr<const OrderArchive> archive,
+        std::size_t cold_orders, std::uint64_t version)
+        : chunks_(std::move(chunks))
+        , strings_(std::move(strings))
+        , archive_(std::move(archive))
+        , hot_slots_(hot_slots)
+        , hot_orders_(hot_orders)
+        , cold_orders_(cold_orders)
+        , version_(version)
+    {
+    }
+
+    // 订单数（热 + 冷）
+    std::size_t size() const { return hot_orders_ + cold_orders_; }
+    // 位置空间的结束位置：先是热存储槽位，随后是冷存储记录
+    std::size_t end() const { return hot_slots_ + cold_orders_; }
+    std::uint64_t version() const { return version_; }
+
+    // 从 position 开始遍历匹配的订单，fn 返回 false 时停止；返回下一个待访问的位置。
+    // 过滤直接比较状态列与账户 id 列，只有匹配的订单才会还原为 common::Order。
+    template <typename Fn>
+    std::size_t scan(std::size_t position, const OrderFilter& filter, Fn&& fn) const
+    {
+        std::optional<std::uint32_t> account;
+        if (filter.account) {
+            account = findName(*filter.account);
+            if (!account)
+                return end();
+        }
+        for (; position < hot_slots_; ++position) {
+            const auto& chunk = *chunks_[position / OrderChunk::kCapacity];
+            auto slot = position % OrderChunk::kCapacity;
+            if (!chunk.live[slot])
+                continue;
+            if (filter.state && chunk.state[slot] != *filter.state)
+                continue;
+            if (account && chunk.account[slot] != *account)
+                continue;
+            if (!fn(chunk.load(slot, *strings_)))
+                return position + 1;
+        }
+        for (; position < end(); ++position) {
+            const auto& r = archive_->record(position - hot_slots_);
+            if (filter.state && r.state != *filter.state)
+                continue;
+            if (account && r.account != *account)
+                continue;
+            if (!fn(archive_->load(position - hot_slots_)))
+                return position + 1;
+        }
+        return end();
+    }
+
+    // 遍历全部订单的记录视图（不还原 std::string），用于快照落盘；先冷后热，大致保持订单的先后顺序
+    template <typename Fn>
+    void forEachRecord(Fn&& fn) const
+    {
+        for (std::size_t i = 0; i < cold_orders_; ++i)
+            fn(archive_->view(i));
+        for (std::size_t position = 0; position < hot_slots_; ++position) {
+            const auto& chunk = *chunks_[position / OrderChunk::kCapacity];
+            auto slot = position % OrderChunk::kCapacity;
+            if (chunk.live[slot])
+                fn(chunk.view(slot, *strings_));
+        }
+    }
+
+private:
+    std::optional<std::uint32_t> findName(const std::string& name) const
+    {
+        // 驻留表的哈希索引只供写者使用，这里线性查找（账户/品种数量有限）
+        for (std::size_t id = 0, n = strings_->names.size(); id < n; ++id) {
+            if (strings_->names.name(static_cast<std::uint32_t>(id)) == name)
+                return static_cast<std::uint32_t>(id);
+        }
+        return std::nullopt;
+    }
+
+private:
+    std::vector<std::shared_ptr<const OrderChunk>> chunks_;
+    std::shared_ptr<const OrderStrings> strings_;
+    std::shared_ptr<const OrderArchive> archive_;
+    std::size_t hot_slots_ { 0 };
+    std::size_t hot_orders_ { 0 };
+    std::size_t cold_orders_ { 0 };
+    std::uint64_t version_ { 0 };
+};
+
+// 分页游标：分片下标 + 分片内位置
+struct OrderCursor {
+    std::size_t shard { 0 };
+    std::size_t position { 0 };
+    bool end { false };
+};
+
+// 跨分片的只读视图；各分片快照各自保持一致的时间点
+class OrderView {
+public:
+    explicit OrderView(std::vector<std::shared_ptr<const OrderSnapshot>> shards)
+        : shards_(std::move(shards))
+    {
+    }
+
+    std::size_t size() const
+    {
+        std::size_t n = 0;
+        for (const auto& s : shards_)
+            n += s->size();
+        return n;
+    }
+
+    template <typename Fn>
+    void forEach(const OrderFilter& filter, Fn&& fn) const
+    {
+        for (const auto& s : shards_)
+            s->scan(0, filter, [&](const common::Order& o) {
+                fn(o);
+                return true;
+            });
+    }
+
+    // 从 cursor 开始最多取 limit 条匹配 filter 的订单追加到 out，返回下一页的游标
+    OrderCursor page(
+        OrderCursor cursor, std::size_t limit, const OrderFilter& filter, std::vector<common::Order>& out) const
+    {
+        std::size_t taken = 0;
+        while (!cursor.end && cursor.shard < shards_.size()) {
+            if (taken == limit)
+                return cursor;
+            cursor.position = shards_[cursor.shard]->scan(cursor.position, filter, [&](const common::Order& o) {
+                out.push_back(o);
+                return ++taken < limit;
+            });
+            if (cursor.position >= shards_[cursor.shard]->end()) {
+                ++cursor.shard;
+                cursor.position = 0;
+            }
+        }
+        cursor.end = true;
+        return cursor;
+    }
+
+private:
+    std::vector<std::shared_ptr<const OrderSnapshot>> shards_;
+};
@@ -0,0 +1,184 @@
+#include "order_store.h"
+
+OrderStore::OrderStore()
+    : strings_(std::make_shared<OrderStrings>())
+    , archive_(std::make_shared<OrderArchive>(strings_))
+{
+}
+
+OrderHandle OrderStore::insert(const OrderRecordView& order)
+{
+    auto handle = allocateSlot();
+    auto& chunk = mutableChunk(handle);
+    auto slot = slotOf(handle);
+    chunk.store(slot, order, *strings_);
+    ++live_count_;
+    by_cl_ord_id_.emplace(ClOrdKey { chunk.session[slot], strings_->ids.view(chunk.cl_ord_id[slot]) }, handle);
+    if (!order.order_id.empty())
+        by_order_id_.emplace(strings_->ids.view(chunk.order_id[slot]), handle);
+    if (common::isTerminal(chunk.state[slot]))
+        terminal_.push_back(handle);
+    bumpVersion();
+    enforceHotCapacity();
+    return handle;
+}
+
+OrderHandle OrderStore::findByClOrdId(std::string_view session, std::string_view clOrdId) const
+{
+    auto id = strings_->names.find(session);
+    if (!id)
+        return kInvalidOrderHandle;
+    auto it = by_cl_ord_id_.find(ClOrdKey { *id, clOrdId });
+    return it == by_cl_ord_id_.end() ? kInvalidOrderHandle : it->second;
+}
+
+OrderHandle OrderStore::findByOrderId(std::string_view orderId) const
+{
+    auto it = by_order_id_.find(orderId);
+    return it == by_order_id_.end() ? kInvalidOrderHandle : it->second;
+}
+
+std::optional<common::Order> OrderStore::findArchivedByClOrdId(
+    std::string_view session, std::string_view clOrdId) const
+{
+    auto id = strings_->names.find(session);
+    if (!id)
+        return std::nullopt;
+    auto index = archive_->findByClOrdId(*id, clOrdId);
+    if (!index)
+        return std::nullopt;
+    return archive_->load(*index);
+}
+
+std::optional<common::Order> OrderStore::findArchivedByOrderId(std::string_view orderId) const
+{
+    auto index = archive_->findByOrderId(orderId);
+    if (!index)
+        return std::nullopt;
+    return archive_->load(*index);
+}
+
+void OrderStore::setState(OrderHandle handle, common::OrderState state)
+{
+    auto& chunk = mutableChunk(handle);
+    auto slot = slotOf(handle);
+    bool was_terminal = common::isTerminal(chunk.state[slot]);
+    chunk.state[slot] = state;
+    if (!was_terminal && common::isTerminal(state))
+        terminal_.push_back(handle);
+    bumpVersion();
+    enforceHotCapacity();
+}
+
+void OrderStore::setFill(OrderHandle handle, std::int64_t cum_qty, std::int64_t avg_px, common::OrderState state)
+{
+    auto& chunk = mutableChunk(handle);
+    auto slot = slotOf(handle);
+    chunk.cum_qty[slot] = cum_qty;
+    chunk.avg_px[slot] = avg_px;
+    setState(handle, state);
+}
+
+void OrderStore::reserve(std::size_t count)
+{
+    chunks_.reserve((count + OrderChunk::kCapacity - 1) / OrderChunk::kCapacity);
+    by_cl_ord_id_.reserve(count);
+    by_order_id_.reserve(count);
+}
+
+OrderStoreMetrics OrderStore::metrics() const
+{
+    OrderStoreMetrics m;
+    m.hot_orders = live_count_;
+    m.hot_slots = slots_;
+    m.cold_orders = archive_->size();
+    m.cold_bytes = archive_->memoryBytes();
+    m.evictions = evictions_;
+    return m;
+}
+
+std::shared_ptr<const OrderSnapshot> OrderStore::publish()
+{
+    auto version = version_.load(std::memory_order_relaxed);
+    auto current = published_.load(std::memory_order_relaxed);
+    if (current && current->version() == version)
+        return current;
+    std::vector<std::shared_ptr<const OrderChunk>> chunks(chunks_.begin(), chunks_.end());
+    auto snapshot = std::make_shared<const OrderSnapshot>(
+        std::move(chunks), strings_, slots_, live_count_, archive_, archive_->size(), version);
+    published_.store(snapshot, std::memory_order_release);
+    return snapshot;
+}
+
+bool OrderStore::snapshotCurrent() const
+{
+    auto current = published_.load(std::memory_order_acquire);
+    return current && current->version() == version_.load(std::memory_order_acquire);
+}
+
+OrderChunk& OrderStore::mutableChunk(OrderHandle handle)
+{
+    auto& chunk = chunks_[handle / OrderChunk::kCapacity];
+    // 只有写者会增加块的引用计数，use_count() == 1 时可以安全地原地修改
+    if (chunk.use_count() > 1)
+        chunk = std::make_shared<OrderChunk>(*chunk);
+    return *chunk;
+}
+
+OrderHandle OrderStore::allocateSlot()
+{
+    if (!free_slots_.empty()) {
+        auto handle = free_slots_.back();
+        free_slots_.pop_back();
+        return handle;
+    }
+    if (slots_ % OrderChunk::kCapacity == 0)
+        chunks_.push_back(std::make_shared<OrderChunk>());
+    return static_cast<OrderHandle>(slots_++);
+}
+
+void OrderStore::enforceHotCapacity()
+{
+    if (hot_capacity_ == 0)
+        return;
+    while (live_count_ > hot_capacity_ && !terminal_.empty()) {
+        evict(terminal_.front());
+        terminal_.pop_front();
+    }
+}
+
+void OrderStore::evict(OrderHandle handle)
+{
+    auto& chunk = mutableChunk(handle);
+    auto slot = slotOf(handle);
+
+    ArchivedOrder record;
+    record.cl_ord_id = chunk.cl_ord_id[slot];
+    record.order_id = chunk.order_id[slot];
+    record.symbol = chunk.symbol[slot];
+    record.account = chunk.account[slot];
+    record.session = chunk.session[slot];
+    record.quantity = chunk.quantity[slot];
+    record.price = chunk.price[slot];
+    record.cum_qty = chunk.cum_qty[slot];
+    record.avg_px = chunk.avg_px[slot];
+    record.side = chunk.side[slot];
+    record.order_type = chunk.order_type[slot];
+    record.time_in_force = chunk.time_in_force[slot];
+    record.state = chunk.state[slot];
+    archive_->append(record);
+
+    // 只删除仍指向该槽位的索引项（重复的 ClOrdID 可能指向更早的订单）
+    auto it = by_cl_ord_id_.find(ClOrdKey { record.session, strings_->ids.view(record.cl_ord_id) });
+    if (it != by_cl_ord_id_.end() && it->second == handle)
+        by_cl_ord_id_.erase(it);
+    auto jt = by_order_id_.find(strings_->ids.view(record.order_id));
+    if (jt != by_order_id_.end() && jt->second == handle)
+        by_order_id_.erase(jt);
+
+    chunk.live[slot] = false;
+    free_slots_.push_back(handle);
+    --live_count_;
+    ++evictions_;
+    bumpVersion();
+}
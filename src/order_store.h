@@ -0,0 +1,119 @@
+#pragma once
+
+#include "common_types.h"
+#include "order_archive.h"
+#include "order_chunk.h"
+#include "order_snapshot.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// 订单句柄：订单在热存储中的槽位下标，在订单留在热存储期间保持稳定，
+// 调用方拿到句柄后可以直接读取/更新，无需再次按 ClOrdID 查找
+using OrderHandle = std::uint32_t;
+inline constexpr OrderHandle kInvalidOrderHandle = std::numeric_limits<OrderHandle>::max();
+
+struct OrderStoreMetrics {
+    std::size_t hot_orders { 0 };
+    std::size_t hot_slots { 0 };
+    std::size_t cold_orders { 0 };
+    std::size_t cold_bytes { 0 };
+    std::uint64_t evictions { 0 };
+
+    OrderStoreMetrics& operator+=(const OrderStoreMetrics& o)
+    {
+        hot_orders += o.hot_orders;
+        hot_slots += o.hot_slots;
+        cold_orders += o.cold_orders;
+        cold_bytes += o.cold_bytes;
+        evictions += o.evictions;
+        return *this;
+    }
+};
+
+// 按 (会话, ClOrdID) 与 OrderID 建立哈希索引的订单存储，查找与状态更新均为 O(1)。
+// 内部为列式定长块 + 驻留字符串 + 枚举状态 + 定点数，common::Order 只在边界上还原。
+// 热存储超过容量上限时，最早进入终态的订单被淘汰到只追加的冷存储（OrderArchive），槽位复用。
+// 写操作非线程安全，由调用方（DomainService 分片）保证单写者；
+// 读者通过 publish() 发布的快照（RCU 方式）无锁读取，标记为线程安全的接口可在任意线程调用。
+class OrderStore {
+public:
+    OrderStore();
+
+    // 热存储中订单数量上限，0 表示不淘汰
+    void setHotCapacity(std::size_t capacity) { hot_capacity_ = capacity; }
+
+    // 插入订单并返回句柄；ClOrdID/OrderID 重复时索引保留最早的订单（与原线性查找的语义一致）
+    OrderHandle insert(const common::Order& order) { return insert(OrderRecordView::of(order)); }
+    OrderHandle insert(const OrderRecordView& order);
+
+    // 只查找热存储；ClOrdID 在下单会话内查找
+    OrderHandle findByClOrdId(std::string_view session, std::string_view clOrdId) const;
+    OrderHandle findByOrderId(std::string_view orderId) const;
+    // 冷存储中的终态订单
+    std::optional<common::Order> findArchivedByClOrdId(std::string_view session, std::string_view clOrdId) const;
+    std::optional<common::Order> findArchivedByOrderId(std::string_view orderId) const;
+
+    common::Order get(OrderHandle handle) const { return chunkOf(handle).load(slotOf(handle), *strings_); }
+    OrderRecordView view(OrderHandle handle) const { return chunkOf(handle).view(slotOf(handle), *strings_); }
+    common::OrderState state(OrderHandle handle) const { return chunkOf(handle).state[slotOf(handle)]; }
+    std::string_view clOrdId(OrderHandle handle) const
+    {
+        return strings_->ids.view(chunkOf(handle).cl_ord_id[slotOf(handle)]);
+    }
+    std::string_view orderId(OrderHandle handle) const
+    {
+        return strings_->ids.view(chunkOf(handle).order_id[slotOf(handle)]);
+    }
+    // 进入终态的订单排队等待淘汰；句柄在订单被淘汰后失效
+    void setState(OrderHandle handle, common::OrderState state);
+    // 成交后更新累计成交量（定点数）、成交均价与状态
+    void setFill(OrderHandle handle, std::int64_t cum_qty, std::int64_t avg_px, common::OrderState state);
+
+    std::size_t size() const { return live_count_; }
+    void reserve(std::size_t count);
+    OrderStoreMetrics metrics() const;
+
+    // 发布当前版本的快照：只复制块指针，被快照引用的块在下次写入时才复制
+    std::shared_ptr<const OrderSnapshot> publish();
+
+    // 线程安全：最近一次发布的快照，以及它是否已是最新版本
+    std::shared_ptr<const OrderSnapshot> latestSnapshot() const { return published_.load(std::memory_order_acquire); }
+    bool snapshotCurrent() const;
+
+private:
+    static std::size_t slotOf(OrderHandle handle) { return handle % OrderChunk::kCapacity; }
+    const OrderChunk& chunkOf(OrderHandle handle) const { return *chunks_[handle / OrderChunk::kCapacity]; }
+    OrderChunk& mutableChunk(OrderHandle handle);
+    OrderHandle allocateSlot();
+    void enforceHotCapacity();
+    void evict(OrderHandle handle);
+    void bumpVersion() { version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    std::vector<std::shared_ptr<OrderChunk>> chunks_;
+    std::size_t slots_ { 0 };
+    std::size_t live_count_ { 0 };
+    std::vector<OrderHandle> free_slots_;
+    std::shared_ptr<OrderStrings> strings_;
+    // 键为指向文本区的 string_view，不再为每个订单额外分配索引字符串
+    std::unordered_map<ClOrdKey, OrderHandle, ClOrdKeyHash> by_cl_ord_id_;
+    std::unordered_map<std::string_view, OrderHandle> by_order_id_;
+
+    std::size_t hot_capacity_ { 0 };
+    std::deque<OrderHandle> terminal_; // 按进入终态的先后排列
+    std::shared_ptr<OrderArchive> archive_;
+    std::uint64_t evictions_ { 0 };
+
+    std::atomic<std::uint64_t> version_ { 0 };
+    std::atomic<std::shared_ptr<const OrderSnapshot>> published_;
+};
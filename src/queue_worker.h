@@ -0,0 +1,249 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+// 有界多生产者单消费者环形队列（Vyukov 算法，每个槽位带序号）：
+// 生产者以 CAS 抢占写位置，消费者独占读位置，都不加锁。容量向上取 2 的幂。
+template <typename T>
+class MpscRing {
+public:
+    explicit MpscRing(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        slots_ = std::make_unique<Slot[]>(size);
+        mask_ = size - 1;
+        for (std::size_t i = 0; i < size; ++i)
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // 队列满时返回 false（此时 value 未被移走）
+    template <typename U>
+    bool tryPush(U&& value)
+    {
+        auto pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& slot = slots_[pos & mask_];
+            auto seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::forward<U>(value);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // 仅消费者线程调用
+    bool tryPop(T& out)
+    {
+        auto& slot = slots_[tail_ & mask_];
+        if (slot.seq.load(std::memory_order_acquire) != tail_ + 1)
+            return false;
+        out = std::move(slot.value);
+        slot.seq.store(tail_ + mask_ + 1, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+
+    bool empty() const { return slots_[tail_ & mask_].seq.load(std::memory_order_acquire) != tail_ + 1; }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq { 0 };
+        T value {};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ { 0 };
+    alignas(64) std::atomic<std::size_t> head_ { 0 };
+    alignas(64) std::size_t tail_ { 0 };
+};
+
+// 队列深度与延迟统计（自启动以来）
+struct QueueMetrics {
+    std::string name;
+    std::uint64_t enqueued { 0 };
+    std::uint64_t processed { 0 };
+    std::uint64_t dropped { 0 };
+    std::uint64_t depth { 0 }; // 已入队未处理完
+    double avg_wait_us { 0 }; // 入队到开始处理
+    double max_wait_us { 0 };
+    double avg_service_us { 0 }; // 处理耗时
+    double max_service_us { 0 };
+};
+
+// 一个有界 MPSC 队列加一个消费线程：生产方入队即返回，元素在消费线程上按入队顺序处理。
+// 消费线程在队列空时短暂自旋后休眠，生产方只在其休眠时才唤醒，平时不做系统调用。
+// 线程安全；stop() 须在生产方停止入队之后调用。
+template <typename T>
+class QueueWorker {
+public:
+    using Handler = std::function<void(T&)>;
+
+    QueueWorker(std::string name, std::size_t capacity, Handler handler)
+        : name_(std::move(name))
+        , handler_(std::move(handler))
+        , ring_(capacity)
+    {
+        thread_ = std::thread([this] { run(); });
+    }
+    ~QueueWorker() { stop(); }
+
+    QueueWorker(const QueueWorker&) = delete;
+    QueueWorker& operator=(const QueueWorker&) = delete;
+
+    // 队列满时等待（向生产方施加背压）
+    void push(T value)
+    {
+        Item item { std::move(value), now() };
+        while (!ring_.tryPush(std::move(item))) {
+            wake();
+            std::this_thread::yield();
+        }
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+        wake();
+    }
+
+    // 队列满时丢弃并计数，返回是否入队
+    bool offer(T value)
+    {
+        if (!ring_.tryPush(Item { std::move(value), now() })) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+        wake();
+        return true;
+    }
+
+    // 处理完已入队的元素后停止消费线程
+    void stop()
+    {
+        if (!thread_.joinable())
+            return;
+        stopping_.store(true, std::memory_order_release);
+        wake();
+        thread_.join();
+    }
+
+    const std::string& name() const { return name_; }
+
+    QueueMetrics metrics() const
+    {
+        QueueMetrics m;
+        m.name = name_;
+        m.enqueued = enqueued_.load(std::memory_order_relaxed);
+        m.processed = processed_.load(std::memory_order_relaxed);
+        m.dropped = dropped_.load(std::memory_order_relaxed);
+        m.depth = m.enqueued > m.processed ? m.enqueued - m.processed : 0;
+        if (m.processed > 0) {
+            m.avg_wait_us = wait_ns_.load(std::memory_order_relaxed) / 1e3 / m.processed;
+            m.avg_service_us = service_ns_.load(std::memory_order_relaxed) / 1e3 / m.processed;
+        }
+        m.max_wait_us = max_wait_ns_.load(std::memory_order_relaxed) / 1e3;
+        m.max_service_us = max_service_ns_.load(std::memory_order_relaxed) / 1e3;
+        return m;
+    }
+
+private:
+    struct Item {
+        T value {};
+        std::int64_t enqueued_ns { 0 };
+    };
+
+    static std::int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // 计数只由消费线程写入
+    static void record(std::atomic<std::uint64_t>& total, std::atomic<std::uint64_t>& max, std::int64_t ns)
+    {
+        auto v = static_cast<std::uint64_t>(std::max<std::int64_t>(ns, 0));
+        total.store(total.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+        if (v > max.load(std::memory_order_relaxed))
+            max.store(v, std::memory_order_relaxed);
+    }
+
+    void wake()
+    {
+        // 与消费线程置 waiting 后再检查队列构成 Dekker 式配对，保证不会漏掉唤醒
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting_.load(std::memory_order_relaxed)) {
+            signal_.fetch_add(1, std::memory_order_release);
+            signal_.notify_one();
+        }
+    }
+
+    void run()
+    {
+        constexpr int kSpins = 64;
+        Item item;
+        int idle = 0;
+        for (;;) {
+            if (ring_.tryPop(item)) {
+                idle = 0;
+                auto start = now();
+                record(wait_ns_, max_wait_ns_, start - item.enqueued_ns);
+                try {
+                    handler_(item.value);
+                } catch (const std::exception& e) {
+                    SPDLOG_ERROR("QueueWorker {} error: {}", name_, e.what());
+                }
+                record(service_ns_, max_service_ns_, now() - start);
+                processed_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (stopping_.load(std::memory_order_acquire) && ring_.empty())
+                return;
+            if (++idle < kSpins) {
+                std::this_thread::yield();
+                continue;
+            }
+            auto ticket = signal_.load(std::memory_order_acquire);
+            waiting_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ring_.empty() && !stopping_.load(std::memory_order_acquire))
+                signal_.wait(ticket, std::memory_order_acquire);
+            waiting_.store(false, std::memory_order_relaxed);
+            idle = 0;
+        }
+    }
+
+private:
+    std::string name_;
+    Handler handler_;
+    MpscRing<Item> ring_;
+    std::atomic<bool> waiting_ { false };
+    std::atomic<std::uint32_t> signal_ { 0 };
+    std::atomic<bool> stopping_ { false };
+    std::atomic<std::uint64_t> enqueued_ { 0 };
+    std::atomic<std::uint64_t> processed_ { 0 };
+    std::atomic<std::uint64_t> dropped_ { 0 };
+    std::atomic<std::uint64_t> wait_ns_ { 0 };
+    std::atomic<std::uint64_t> max_wait_ns_ { 0 };
+    std::atomic<std::uint64_t> service_ns_ { 0 };
+    std::atomic<std::uint64_t> max_service_ns_ { 0 };
+    std::thread thread_;
+};
@@ -0,0 +1,132 @@
+#include "risk_engine.h"
+
+#include <cmath>
+
+RiskEngine::RiskEngine(const RiskConfig& config)
+    : config_(config)
+{
+    // 预先为配置了限额的账户建表
+    for (const auto& [name, limits] : config_.accounts)
+        account(name);
+}
+
+RiskEngine::Result RiskEngine::checkNew(const common::Order& order)
+{
+    auto r = checkBasic(order);
+    if (!r.ok)
+        return r;
+    if (order.symbol.empty())
+        return { false, "Empty symbol" };
+    auto& acc = account(order.account);
+    r = checkLimits(order, acc);
+    if (!r.ok)
+        return r;
+    auto max_open = acc.limits.max_open_orders;
+    if (acc.open_orders.fetch_add(1, std::memory_order_relaxed) >= max_open && max_open > 0) {
+        acc.open_orders.fetch_sub(1, std::memory_order_relaxed);
+        return { false, "Open order limit exceeded" };
+    }
+    return {};
+}
+
+RiskEngine::Result RiskEngine::checkReplace(const common::Order& order)
+{
+    auto r = checkBasic(order);
+    if (!r.ok)
+        return r;
+    // 改单请求不一定带账户，此时只做基本检查
+    if (order.account.empty())
+        return {};
+    return checkLimits(order, account(order.account));
+}
+
+void RiskEngine::onOrderAccepted(const common::Order& order)
+{
+    if (order.orderType != '1' && order.price > 0)
+        symbol(order.symbol).ref_price.store(common::toFixed(order.price), std::memory_order_relaxed);
+}
+
+void RiskEngine::onOrderClosed(const common::Order& order)
+{
+    account(order.account).open_orders.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void RiskEngine::onOrderRecovered(const common::Order& order)
+{
+    account(order.account).open_orders.fetch_add(1, std::memory_order_relaxed);
+    onOrderAccepted(order);
+}
+
+RiskEngine::AccountState& RiskEngine::account(const std::string& name)
+{
+    return accounts_.get(name, [&](AccountState& acc) {
+        auto it = config_.accounts.find(name);
+        acc.limits = it == config_.accounts.end() ? config_.defaults : it->second;
+    });
+}
+
+RiskEngine::SymbolState& RiskEngine::symbol(const std::string& name)
+{
+    return symbols_.get(name, [](SymbolState&) {});
+}
+
+RiskEngine::Result RiskEngine::checkBasic(const common::Order& order) const
+{
+    if (order.quantity <= 0)
+        return { false, "Invalid quantity" };
+    // 非市价单需要价格
+    if (order.orderType != '1' && order.price <= 0)
+        return { false, "Non-market order requires price" };
+    return {};
+}
+
+RiskEngine::Result RiskEngine::checkLimits(const common::Order& order, AccountState& acc)
+{
+    const auto& limits = acc.limits;
+    if (limits.max_msgs_per_sec > 0 && !allowMessage(acc))
+        return { false, "Message rate limit exceeded" };
+    if (limits.max_order_qty > 0 && order.quantity > limits.max_order_qty)
+        return { false, "Order quantity exceeds limit" };
+
+    bool limit_order = order.orderType != '1';
+    double ref = 0;
+    if (!order.symbol.empty() && (limits.max_order_notional > 0 || limits.price_band > 0))
+        ref = common::fromFixed(symbol(order.symbol).ref_price.load(std::memory_order_relaxed));
+
+    // 市价单按参考价估算名义金额，尚无参考价时不检查
+    double price = limit_order ? order.price : ref;
+    if (limits.max_order_notional > 0 && order.quantity * price > limits.max_order_notional)
+        return { false, "Order notional exceeds limit" };
+    if (limit_order && limits.price_band > 0 && ref > 0 && std::abs(order.price - ref) > ref * limits.price_band)
+        return { false, "Price outside band" };
+    return {};
+}
+
+bool RiskEngine::allowMessage(AccountState& acc)
+{
+    // 两个一秒的桶近似滑动窗口：估计值 = 上一秒计数 × 上一秒仍在窗口内的比例 + 本秒计数
+    auto now = std::chrono::steady_clock::now() - epoch_;
+    auto sec = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(now).count());
+    auto window = acc.window.load(std::memory_order_relaxed);
+    for (;;) {
+        auto window_sec = window >> 32;
+        std::uint64_t next;
+        if (window_sec == sec) {
+            next = window + 1;
+        } else {
+            next = (sec << 32) | 1;
+        }
+        if (acc.window.compare_exchange_weak(window, next, std::memory_order_relaxed)) {
+            if (window_sec != sec) {
+                auto prev = window_sec + 1 == sec ? static_cast<std::uint32_t>(window) : 0u;
+                acc.prev_count.store(prev, std::memory_order_relaxed);
+            }
+            window = next;
+            break;
+        }
+    }
+    auto count = static_cast<std::uint32_t>(window);
+    auto elapsed = std::chrono::duration<double>(now).count() - static_cast<double>(sec);
+    auto estimate = acc.prev_count.load(std::memory_order_relaxed) * (1.0 - elapsed) + count;
+    return estimate <= acc.limits.max_msgs_per_sec;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "app_config.h"
+#include "common_types.h"
+#include "concurrent_registry.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// 事前风控：单笔数量/名义金额、挂单数、每秒消息数（滑动窗口）与限价偏离参考价的价格带。
+// 账户限额在构造时预先编译成账户表（未配置的账户首次出现时按默认限额建表），
+// 之后的检查只读取限额并更新原子计数器，不做字符串解析或日志输出；账户表与品种表的查找不加锁。
+// 线程安全。
+class RiskEngine {
+public:
+    struct Result {
+        bool ok { true };
+        const char* reason { "" };
+    };
+
+    explicit RiskEngine(const RiskConfig& config = {});
+
+    // 通过时为该账户占用一个挂单名额；订单最终未被接受时须调用 onOrderClosed 归还
+    Result checkNew(const common::Order& order);
+    Result checkReplace(const common::Order& order);
+
+    // 订单被接受（更新参考价）/ 离开挂单（撤单、改单、全部成交，归还挂单名额）
+    void onOrderAccepted(const common::Order& order);
+    void onOrderClosed(const common::Order& order);
+    // 启动恢复时计入已有的挂单
+    void onOrderRecovered(const common::Order& order);
+
+private:
+    struct AccountState {
+        RiskLimits limits;
+        std::atomic<std::uint32_t> open_orders { 0 };
+        // 高 32 位为秒，低 32 位为该秒内的消息数
+        std::atomic<std::uint64_t> window { 0 };
+        std::atomic<std::uint32_t> prev_count { 0 };
+    };
+
+    struct SymbolState {
+        std::atomic<std::int64_t> ref_price { 0 }; // 定点数，0 表示尚无参考价
+    };
+
+    AccountState& account(const std::string& name);
+    SymbolState& symbol(const std::string& name);
+    Result checkBasic(const common::Order& order) const;
+    Result checkLimits(const common::Order& order, AccountState& acc);
+    bool allowMessage(AccountState& acc);
+
+private:
+    RiskConfig config_;
+    ConcurrentRegistry<AccountState> accounts_;
+    ConcurrentRegistry<SymbolState> symbols_;
+    const std::chrono::steady_clock::time_point epoch_ { std::chrono::steady_clock::now() };
+};
@@ -0,0 +1,64 @@
+#include "session_registry.h"
+
+SessionContext::SessionContext(const FIX::SessionID& sessionID)
+    : id_(sessionID)
+    , key_(sessionID.toString())
+{
+}
+
+bool SessionContext::clOrdIdUsed(const std::string& clOrdId, std::int64_t day) const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return cl_ord_ids_ && day_ == day && cl_ord_ids_->contains(clOrdId);
+}
+
+bool SessionContext::registerClOrdId(const std::string& clOrdId, std::int64_t day)
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    // 交易日切换后重新计数
+    if (!cl_ord_ids_ || day_ != day) {
+        day_ = day;
+        cl_ord_ids_ = std::make_unique<ClOrdIdFilter>();
+    }
+    return cl_ord_ids_->insert(clOrdId);
+}
+
+void SessionContext::subscribeAccount(const std::string& account)
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    accounts_.insert(account);
+}
+
+bool SessionContext::subscribed(const std::string& account) const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return accounts_.count(account) != 0;
+}
+
+SessionContext& SessionRegistry::add(const FIX::SessionID& sessionID)
+{
+    std::lock_guard<std::mutex> lk(write_mtx_);
+    auto key = sessionID.toString();
+    const auto* current = current_.load(std::memory_order_relaxed);
+    if (current) {
+        auto it = current->by_key.find(key);
+        if (it != current->by_key.end())
+            return *it->second;
+    }
+    auto& context = *contexts_.emplace_back(std::make_unique<SessionContext>(sessionID));
+    auto index = current ? std::make_unique<Index>(*current) : std::make_unique<Index>();
+    index->by_key.emplace(context.key(), &context);
+    index->sessions.push_back(&context);
+    current_.store(index.get(), std::memory_order_release);
+    versions_.push_back(std::move(index));
+    return context;
+}
+
+SessionContext* SessionRegistry::find(std::string_view key) const
+{
+    const auto* index = current_.load(std::memory_order_acquire);
+    if (!index)
+        return nullptr;
+    auto it = index->by_key.find(key);
+    return it == index->by_key.end() ? nullptr : it->second;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "clordid_filter.h"
+
+#include <quickfix/SessionID.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// 单个 FIX 会话的上下文。订单上记录的 session 即 key，执行回报按它找回会话
+class SessionContext {
+public:
+    explicit SessionContext(const FIX::SessionID& sessionID);
+
+    SessionContext(const SessionContext&) = delete;
+    SessionContext& operator=(const SessionContext&) = delete;
+
+    const FIX::SessionID& id() const { return id_; }
+    const std::string& key() const { return key_; }
+    bool loggedOn() const { return logged_on_.load(std::memory_order_acquire); }
+    // 返回之前的状态
+    bool setLoggedOn(bool value) { return logged_on_.exchange(value, std::memory_order_acq_rel); }
+
+    // ClOrdID 当天（UTC，day 为纪元日）是否已登记过
+    bool clOrdIdUsed(const std::string& clOrdId, std::int64_t day) const;
+    // 登记已接受订单的 ClOrdID；当天已登记过时返回 false
+    bool registerClOrdId(const std::string& clOrdId, std::int64_t day);
+    // 保证金订阅：会话下过单的账户
+    void subscribeAccount(const std::string& account);
+    bool subscribed(const std::string& account) const;
+
+private:
+    const FIX::SessionID id_;
+    const std::string key_;
+    std::atomic<bool> logged_on_ { false };
+
+    mutable std::mutex mtx_;
+    std::int64_t day_ { 0 };
+    std::unique_ptr<ClOrdIdFilter> cl_ord_ids_;
+    std::unordered_set<std::string> accounts_;
+};
+
+// 进程内所有 FIX 会话的登记表。会话只在创建时加入、从不删除（登出只改状态），
+// 写入时复制一份新的索引并原子替换，旧版本保留到登记表析构：
+// 热路径上的查找只做一次原子读和一次哈希查找，不加锁也不改引用计数。
+// 线程安全。
+class SessionRegistry {
+public:
+    // 注册会话（onCreate），已存在时返回已有的上下文
+    SessionContext& add(const FIX::SessionID& sessionID);
+    // 未注册时返回 nullptr
+    SessionContext* find(std::string_view key) const;
+    SessionContext* find(const FIX::SessionID& sessionID) const { return find(sessionID.toString()); }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const
+    {
+        if (const auto* index = current_.load(std::memory_order_acquire)) {
+            for (auto* session : index->sessions)
+                fn(*session);
+        }
+    }
+
+private:
+    struct Index {
+        std::unordered_map<std::string_view, SessionContext*> by_key; // 键指向 SessionContext::key()
+        std::vector<SessionContext*> sessions;
+    };
+
+    std::mutex write_mtx_;
+    std::vector<std::unique_ptr<SessionContext>> contexts_;
+    std::vector<std::unique_ptr<const Index>> versions_;
+    std::atomic<const Index*> current_ { nullptr };
+};
@@ -0,0 +1,71 @@
+#include "shard_worker.h"
+
+ShardWorker::ShardWorker(std::size_t queue_capacity)
+    : queue_(queue_capacity)
+{
+}
+
+ShardWorker::~ShardWorker() { stop(); }
+
+void ShardWorker::start()
+{
+    bool expected = false;
+    if (!running_.compare_exchange_strong(expected, true))
+        return;
+    active_.store(true);
+    thread_ = std::thread([this] { loop(); });
+}
+
+void ShardWorker::stop()
+{
+    bool expected = true;
+    if (!running_.compare_exchange_strong(expected, false))
+        return;
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void ShardWorker::submit(Task& task)
+{
+    // 队列节点不足时 push 会向系统申请新节点，不会丢命令
+    queue_.push(&task);
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+}
+
+void ShardWorker::runPending()
+{
+    Task* task = nullptr;
+    while (queue_.pop(task)) {
+        task->run(task->ctx);
+        task->done.store(true, std::memory_order_release);
+        completed_.fetch_add(1, std::memory_order_release);
+        completed_.notify_all();
+    }
+}
+
+void ShardWorker::runInline()
+{
+    // 调用线程之间互斥，保持单写者
+    std::lock_guard<std::mutex> lk(inline_mtx_);
+    runPending();
+}
+
+void ShardWorker::loop()
+{
+    for (;;) {
+        // 先读取信号值再检查队列，避免错过 submit 与 wait 之间到达的命令
+        auto seen = signal_.load(std::memory_order_acquire);
+        runPending();
+        if (!running_.load(std::memory_order_acquire))
+            break;
+        signal_.wait(seen, std::memory_order_acquire);
+    }
+    // 停止后仍把已入队的命令执行完；此后入队的命令由调用线程自己执行
+    runPending();
+    active_.store(false);
+    completed_.fetch_add(1);
+    completed_.notify_all();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <boost/lockfree/queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// 单写者工作线程：从无锁 MPSC 队列中取出命令并串行执行。
+// execute() 会阻塞调用线程直到命令执行完毕，因此同一调用线程（即同一 FIX 会话）
+// 提交的命令及其回报顺序保持不变。
+// 工作线程未运行时（start() 之前或 stop() 之后），命令由调用线程在锁内逐个执行，不会永久阻塞。
+class ShardWorker {
+public:
+    explicit ShardWorker(std::size_t queue_capacity = 1024);
+    ~ShardWorker();
+
+    ShardWorker(const ShardWorker&) = delete;
+    ShardWorker& operator=(const ShardWorker&) = delete;
+
+    void start();
+    void stop();
+
+    template <typename Fn>
+    void execute(Fn&& fn)
+    {
+        Task task { &invoke<std::remove_reference_t<Fn>>, &fn };
+        submit(task);
+        // 等待在工作线程自己的计数器上：工作线程置位 done 之后不再访问栈上的 task
+        for (;;) {
+            auto completed = completed_.load(std::memory_order_acquire);
+            if (task.done.load(std::memory_order_acquire))
+                break;
+            // 工作线程已退出：自己执行剩余的命令；线程退出时会推进 completed_，等待不会错过退出
+            if (!active_.load()) {
+                runInline();
+                continue;
+            }
+            completed_.wait(completed, std::memory_order_acquire);
+        }
+    }
+
+private:
+    struct Task {
+        void (*run)(void*);
+        void* ctx;
+        std::atomic<bool> done { false };
+    };
+
+    template <typename Fn>
+    static void invoke(void* ctx)
+    {
+        (*static_cast<Fn*>(ctx))();
+    }
+
+    void submit(Task& task);
+    void runPending();
+    void runInline();
+    void loop();
+
+private:
+    boost::lockfree::queue<Task*> queue_;
+    std::atomic<std::uint32_t> signal_ { 0 };
+    std::atomic<std::uint32_t> completed_ { 0 };
+    std::atomic<bool> running_ { false };
+    // 工作线程在取命令：start() 时置位，线程执行完最后一批命令后清除
+    std::atomic<bool> active_ { false };
+    std::mutex inline_mtx_;
+    std::thread thread_;
+};
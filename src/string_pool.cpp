@@ -0,0 +1,47 @@
+#include "string_pool.h"
+
+TextArena::~TextArena()
+{
+    for (auto& b : blocks_)
+        delete[] b.load(std::memory_order_relaxed);
+}
+
+TextRef TextArena::append(std::string_view text)
+{
+    if (text.size() > kBlockSize)
+        throw std::length_error("TextArena: text too long");
+    // 字符串不跨块存放
+    auto offset = used_;
+    if (offset % kBlockSize + text.size() > kBlockSize)
+        offset = (offset / kBlockSize + 1) * kBlockSize;
+    auto block = offset / kBlockSize;
+    if (block >= kMaxBlocks)
+        throw std::length_error("TextArena capacity exceeded");
+    char* data = blocks_[block].load(std::memory_order_relaxed);
+    if (!data) {
+        data = new char[kBlockSize];
+        blocks_[block].store(data, std::memory_order_release);
+    }
+    text.copy(data + offset % kBlockSize, text.size());
+    used_ = offset + text.size();
+    return { static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(text.size()) };
+}
+
+std::optional<std::uint32_t> InternTable::find(std::string_view text) const
+{
+    auto it = ids_.find(text);
+    if (it == ids_.end())
+        return std::nullopt;
+    return it->second;
+}
+
+std::uint32_t InternTable::intern(std::string_view text)
+{
+    auto it = ids_.find(text);
+    if (it != ids_.end())
+        return it->second;
+    auto ref = text_.append(text);
+    auto id = static_cast<std::uint32_t>(names_.push(ref));
+    ids_.emplace(text_.view(ref), id);
+    return id;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// 只追加的分块数组：元素写入后地址不变；单写者追加，读者可无锁读取下标 < size() 的元素
+template <typename T, std::size_t BlockSize, std::size_t MaxBlocks>
+class AppendOnlyVector {
+public:
+    AppendOnlyVector() = default;
+    ~AppendOnlyVector()
+    {
+        for (auto& b : blocks_)
+            delete[] b.load(std::memory_order_relaxed);
+    }
+    AppendOnlyVector(const AppendOnlyVector&) = delete;
+    AppendOnlyVector& operator=(const AppendOnlyVector&) = delete;
+
+    std::size_t push(const T& value)
+    {
+        auto index = size_.load(std::memory_order_relaxed);
+        auto block = index / BlockSize;
+        if (block >= MaxBlocks)
+            throw std::length_error("AppendOnlyVector capacity exceeded");
+        T* data = blocks_[block].load(std::memory_order_relaxed);
+        if (!data) {
+            data = new T[BlockSize];
+            blocks_[block].store(data, std::memory_order_release);
+        }
+        data[index % BlockSize] = value;
+        size_.store(index + 1, std::memory_order_release);
+        return index;
+    }
+
+    const T& operator[](std::size_t index) const
+    {
+        return blocks_[index / BlockSize].load(std::memory_order_acquire)[index % BlockSize];
+    }
+
+    std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+private:
+    std::array<std::atomic<T*>, MaxBlocks> blocks_ {};
+    std::atomic<std::size_t> size_ { 0 };
+};
+
+// 文本区中一段字符串的位置
+struct TextRef {
+    std::uint32_t offset { 0 };
+    std::uint32_t length { 0 };
+};
+
+// 只追加的文本区，用于存放 ClOrdID/OrderID 等不重复的短文本，避免每个字符串单独分配堆内存
+class TextArena {
+public:
+    TextArena() = default;
+    ~TextArena();
+    TextArena(const TextArena&) = delete;
+    TextArena& operator=(const TextArena&) = delete;
+
+    TextRef append(std::string_view text);
+    // 线程安全：ref 必须来自已发布的数据
+    std::string_view view(TextRef ref) const
+    {
+        const char* block = blocks_[ref.offset / kBlockSize].load(std::memory_order_acquire);
+        return { block + ref.offset % kBlockSize, ref.length };
+    }
+
+    std::size_t bytesUsed() const { return used_; }
+
+private:
+    static constexpr std::size_t kBlockSize = 1 << 20;
+    static constexpr std::size_t kMaxBlocks = 4096; // 4 GiB
+
+    std::array<std::atomic<char*>, kMaxBlocks> blocks_ {};
+    std::size_t used_ { 0 };
+};
+
+// 字符串驻留表（品种、账户等取值有限的文本），id 从 0 开始连续分配
+class InternTable {
+public:
+    std::uint32_t intern(std::string_view text);
+    // 只查找不驻留；与 intern() 同在写者上下文中调用
+    std::optional<std::uint32_t> find(std::string_view text) const;
+    // 线程安全
+    std::string_view name(std::uint32_t id) const { return text_.view(names_[id]); }
+    std::size_t size() const { return names_.size(); }
+
+private:
+    TextArena text_;
+    AppendOnlyVector<TextRef, 4096, 4096> names_;
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+};
@@ -0,0 +1,218 @@
+#include "timer_scheduler.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <exception>
+
+TimerScheduler::TimerScheduler(Clock::duration tick)
+    : tick_(std::max<Clock::duration>(tick, std::chrono::microseconds(1)))
+    , epoch_(Clock::now())
+{
+}
+
+TimerScheduler::~TimerScheduler() { stop(); }
+
+std::shared_ptr<TimerScheduler> TimerScheduler::shared()
+{
+    static std::shared_ptr<TimerScheduler> instance = [] {
+        auto s = std::make_shared<TimerScheduler>();
+        s->start();
+        return s;
+    }();
+    return instance;
+}
+
+void TimerScheduler::start()
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (running_)
+        return;
+    running_ = true;
+    thread_ = std::thread([this] { loop(); });
+}
+
+void TimerScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (!running_)
+            return;
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+TimerId TimerScheduler::scheduleAfter(Clock::duration delay, Task task) { return add(delay, {}, std::move(task)); }
+
+TimerId TimerScheduler::scheduleEvery(Clock::duration interval, Task task)
+{
+    return add(interval, std::max<Clock::duration>(interval, tick_), std::move(task));
+}
+
+bool TimerScheduler::cancel(TimerId id)
+{
+    if (id == kInvalidTimerId)
+        return false;
+    std::unique_lock<std::mutex> lk(mtx_);
+    // 槽位中的 id 在到期时发现已不存在即跳过，这里只需删除定时器本身
+    bool found = timers_.erase(id) > 0;
+    if (running_id_ == id && thread_.get_id() != std::this_thread::get_id())
+        idle_cv_.wait(lk, [&] { return running_id_ != id; });
+    return found;
+}
+
+bool TimerScheduler::cancelNoWait(TimerId id)
+{
+    if (id == kInvalidTimerId)
+        return false;
+    std::lock_guard<std::mutex> lk(mtx_);
+    return timers_.erase(id) > 0;
+}
+
+TimerId TimerScheduler::add(Clock::duration delay, Clock::duration interval, Task task)
+{
+    TimerId id;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        id = next_id_++;
+        // 当前刻度已过去一部分，再加一个刻度并向上取整，保证不会早于 delay 触发
+        auto expiry = std::max(nowTick(), current_tick_) + 1 + ticksOf(delay);
+        timers_.emplace(id, Timer { std::move(task), expiry, interval.count() > 0 ? ticksOf(interval) : 0 });
+        place(id, expiry);
+    }
+    cv_.notify_all();
+    return id;
+}
+
+std::uint64_t TimerScheduler::ticksOf(Clock::duration d) const
+{
+    if (d.count() <= 0)
+        return 0;
+    return static_cast<std::uint64_t>((d + tick_ - Clock::duration(1)) / tick_);
+}
+
+std::uint64_t TimerScheduler::nowTick() const { return static_cast<std::uint64_t>((Clock::now() - epoch_) / tick_); }
+
+void TimerScheduler::place(TimerId id, std::uint64_t expiry)
+{
+    expiry = std::max(expiry, current_tick_);
+    for (int level = 0; level < kLevels; ++level) {
+        auto shift = kSlotBits * (level + 1);
+        // expiry 与当前刻度在更高位上一致时，放入本层
+        if ((expiry >> shift) == (current_tick_ >> shift)) {
+            wheel_[level][(expiry >> (kSlotBits * level)) & kSlotMask].push_back(id);
+            return;
+        }
+    }
+    overflow_.push_back(id);
+}
+
+void TimerScheduler::cascade(int level)
+{
+    std::vector<TimerId> ids;
+    if (level == kLevels) {
+        ids.swap(overflow_);
+    } else {
+        ids.swap(wheel_[level][(current_tick_ >> (kSlotBits * level)) & kSlotMask]);
+    }
+    for (auto id : ids) {
+        auto it = timers_.find(id);
+        if (it != timers_.end())
+            place(id, it->second.expiry);
+    }
+}
+
+void TimerScheduler::advance(std::vector<TimerId>& due)
+{
+    ++current_tick_;
+    // 自上而下把到达当前范围的高层槽位下放到低层
+    for (int level = kLevels; level >= 1; --level) {
+        auto mask = (std::uint64_t { 1 } << (kSlotBits * level)) - 1;
+        if ((current_tick_ & mask) == 0)
+            cascade(level);
+    }
+    auto& slot = wheel_[0][current_tick_ & kSlotMask];
+    due.insert(due.end(), slot.begin(), slot.end());
+    slot.clear();
+}
+
+std::uint64_t TimerScheduler::ticksUntilWake() const
+{
+    // 本轮内最近的非空槽位；没有时醒在下一次层级下放
+    auto remaining = kSlots - (current_tick_ & kSlotMask);
+    for (std::uint64_t d = 1; d < remaining; ++d) {
+        if (!wheel_[0][(current_tick_ + d) & kSlotMask].empty())
+            return d;
+    }
+    return remaining;
+}
+
+void TimerScheduler::loop()
+{
+    std::vector<TimerId> due;
+    std::unique_lock<std::mutex> lk(mtx_);
+    while (running_) {
+        if (timers_.empty()) {
+            cv_.wait(lk, [&] { return !running_ || !timers_.empty(); });
+            // 空闲期间无需逐个刻度推进
+            for (auto& level : wheel_) {
+                for (auto& slot : level)
+                    slot.clear();
+            }
+            overflow_.clear();
+            auto earliest = nowTick();
+            for (const auto& [id, timer] : timers_)
+                earliest = std::min(earliest, timer.expiry);
+            current_tick_ = std::max(current_tick_, earliest - 1);
+            for (const auto& [id, timer] : timers_)
+                place(id, timer.expiry);
+            continue;
+        }
+
+        auto target = nowTick();
+        while (current_tick_ < target)
+            advance(due);
+
+        for (auto id : due) {
+            auto it = timers_.find(id);
+            if (it == timers_.end() || it->second.expiry > current_tick_) {
+                // 已取消，或是因跨度超出最高层而提前下放的定时器
+                if (it != timers_.end())
+                    place(id, it->second.expiry);
+                continue;
+            }
+            auto task = it->second.task;
+            running_id_ = id;
+            lk.unlock();
+            try {
+                task();
+            } catch (const std::exception& ex) {
+                SPDLOG_ERROR("Timer task error: {}", ex.what());
+            } catch (...) {
+                SPDLOG_ERROR("Timer task unknown error");
+            }
+            lk.lock();
+            running_id_ = kInvalidTimerId;
+            idle_cv_.notify_all();
+
+            it = timers_.find(id);
+            if (it == timers_.end())
+                continue;
+            if (it->second.interval == 0) {
+                timers_.erase(it);
+                continue;
+            }
+            it->second.expiry = std::max(it->second.expiry + it->second.interval, current_tick_ + 1);
+            place(id, it->second.expiry);
+        }
+        due.clear();
+
+        if (!running_ || timers_.empty())
+            continue;
+        auto wake = epoch_ + tick_ * static_cast<Clock::rep>(current_tick_ + ticksUntilWake());
+        cv_.wait_until(lk, wake);
+    }
+}
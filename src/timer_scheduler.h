@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using TimerId = std::uint64_t;
+inline constexpr TimerId kInvalidTimerId = 0;
+
+// 分层时间轮定时器：4 层 × 256 槽，默认刻度 100us。所有周期性任务共用一个线程，
+// 线程只在最近的非空槽位或下一次层级下放时醒来，没有定时任务时一直休眠，stop()/cancel() 立即生效。
+// 回调在定时器线程上串行执行，应当尽快返回；耗时的工作应交给其他线程。
+// 线程安全。
+class TimerScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Task = std::function<void()>;
+
+    explicit TimerScheduler(Clock::duration tick = std::chrono::microseconds(100));
+    ~TimerScheduler();
+
+    TimerScheduler(const TimerScheduler&) = delete;
+    TimerScheduler& operator=(const TimerScheduler&) = delete;
+
+    // 进程内共享的实例（首次调用时启动）
+    static std::shared_ptr<TimerScheduler> shared();
+
+    void start();
+    void stop();
+
+    TimerId scheduleAfter(Clock::duration delay, Task task);
+    // 周期任务：首次在 interval 之后执行；执行落后时跳过错过的周期，不会连续补执行
+    TimerId scheduleEvery(Clock::duration interval, Task task);
+    // 返回后回调不会再开始执行；若回调正在其他线程执行，等待其结束（在回调内取消自身不会等待）。
+    // 对已取消的定时器再次调用可等待其最后一次回调结束
+    bool cancel(TimerId id);
+    // 同上，但不等待正在执行的回调：用于调用方持有回调可能需要的锁时（如 QuickFIX 回调内持有会话锁）。
+    // 回调捕获的对象须保持有效，直到之后以 cancel() 等待过
+    bool cancelNoWait(TimerId id);
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 8;
+    static constexpr std::uint64_t kSlots = 1 << kSlotBits;
+    static constexpr std::uint64_t kSlotMask = kSlots - 1;
+
+    struct Timer {
+        Task task;
+        std::uint64_t expiry { 0 }; // 刻度
+        std::uint64_t interval { 0 }; // 刻度，0 表示一次性
+    };
+
+    TimerId add(Clock::duration delay, Clock::duration interval, Task task);
+    std::uint64_t ticksOf(Clock::duration d) const;
+    std::uint64_t nowTick() const;
+    void place(TimerId id, std::uint64_t expiry);
+    void cascade(int level);
+    void advance(std::vector<TimerId>& due);
+    std::uint64_t ticksUntilWake() const;
+    void loop();
+
+private:
+    const Clock::duration tick_;
+    const Clock::time_point epoch_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::condition_variable idle_cv_; // cancel() 等待回调结束
+    bool running_ { false };
+    std::thread thread_;
+
+    std::uint64_t current_tick_ { 0 };
+    std::array<std::array<std::vector<TimerId>, kSlots>, kLevels> wheel_;
+    std::vector<TimerId> overflow_; // 超出最高层范围的定时器
+    std::unordered_map<TimerId, Timer> timers_;
+    TimerId next_id_ { 1 };
+    TimerId running_id_ { kInvalidTimerId };
+};
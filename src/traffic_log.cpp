@@ -0,0 +1,374 @@
+#include "traffic_log.h"
+
+#include <quickfix/Fields.h>
+#include <spdlog/fmt/chrono.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kFileMagic[8] = { 'B', 'A', 'T', 'R', 'F', '0', '0', '1' };
+// 环形缓冲末尾放不下一条记录时写入的填充记录
+constexpr std::uint16_t kPadding = 0;
+
+struct RecordHeader {
+    std::uint32_t size; // 含头部，不含对齐填充
+    std::uint16_t format;
+    std::uint16_t reserved;
+    std::int64_t time_ns; // system_clock
+};
+static_assert(sizeof(RecordHeader) == 16);
+
+struct FormatSpec {
+    spdlog::level::level_enum level;
+    const char* text;
+};
+
+const FormatSpec* formatSpec(TrafficFormat format)
+{
+    static const FormatSpec kSpecs[] = {
+        { spdlog::level::info, "fromApp: {}" },
+        { spdlog::level::info, "toApp:   {}" },
+        { spdlog::level::debug, "fromAdmin: {}" },
+        { spdlog::level::debug, "toAdmin: {}" },
+        { spdlog::level::info, "Processing NewOrderSingle: ClOrdID={}, Symbol={}, Qty={}, Price={}" },
+        { spdlog::level::info, "Processing OrderCancelRequest: ClOrdID={}, OrigClOrdID={}" },
+        { spdlog::level::info, "Processing OrderCancelReplaceRequest: ClOrdID={}, OrigClOrdID={}, Qty={}, Price={}" },
+    };
+    auto index = static_cast<std::size_t>(format) - 1;
+    return index < std::size(kSpecs) ? &kSpecs[index] : nullptr;
+}
+
+std::size_t align8(std::size_t n) { return (n + 7) & ~std::size_t(7); }
+
+std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+// 单生产者（所属线程）单消费者（后台线程）的字节环形缓冲，记录按 8 字节对齐、变长
+class TrafficLog::Ring {
+public:
+    explicit Ring(std::size_t bytes)
+    {
+        std::size_t size = 4096;
+        while (size < bytes)
+            size <<= 1;
+        buf_ = std::make_unique<char[]>(size);
+        size_ = size;
+    }
+
+    bool push(TrafficFormat format, std::string_view payload)
+    {
+        RecordHeader header { static_cast<std::uint32_t>(sizeof(RecordHeader) + payload.size()),
+            static_cast<std::uint16_t>(format), 0, nowNs() };
+        auto need = align8(header.size);
+        if (need > size_ / 2)
+            return false;
+        auto head = head_.load(std::memory_order_relaxed);
+        auto offset = head & (size_ - 1);
+        auto contiguous = size_ - offset;
+        auto total = need + (contiguous < need ? contiguous : 0);
+        if (head + total - cached_tail_ > size_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head + total - cached_tail_ > size_)
+                return false;
+        }
+        if (contiguous < need) {
+            // 填充记录只写前 8 字节（size + format）
+            RecordHeader pad { static_cast<std::uint32_t>(contiguous), kPadding, 0, 0 };
+            std::memcpy(buf_.get() + offset, &pad, 8);
+            head += contiguous;
+            offset = 0;
+        }
+        std::memcpy(buf_.get() + offset, &header, sizeof(header));
+        if (!payload.empty())
+            std::memcpy(buf_.get() + offset + sizeof(header), payload.data(), payload.size());
+        head_.store(head + need, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Fn>
+    std::size_t consume(Fn&& fn)
+    {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        auto head = head_.load(std::memory_order_acquire);
+        std::size_t count = 0;
+        while (tail < head) {
+            const char* record = buf_.get() + (tail & (size_ - 1));
+            RecordHeader header;
+            std::memcpy(&header, record, 8);
+            if (header.format == kPadding) {
+                tail += header.size;
+                continue;
+            }
+            fn(record, header.size);
+            tail += align8(header.size);
+            ++count;
+        }
+        tail_.store(tail, std::memory_order_release);
+        return count;
+    }
+
+private:
+    std::unique_ptr<char[]> buf_;
+    std::size_t size_ { 0 };
+    alignas(64) std::atomic<std::uint64_t> head_ { 0 };
+    std::uint64_t cached_tail_ { 0 }; // 仅生产者使用
+    alignas(64) std::atomic<std::uint64_t> tail_ { 0 };
+};
+
+TrafficLog::TrafficLog(const TrafficLogConfig& config)
+    : config_(config)
+    , id_([] {
+        static std::atomic<std::uint64_t> next { 1 };
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }())
+{
+    config_.sample_every = std::max<std::uint32_t>(1, config_.sample_every);
+    default_rule_.verbosity = config_.verbosity;
+    for (const auto& [msgType, verbosity] : config_.msg_types)
+        rules_[msgType].verbosity = verbosity;
+
+    if (config_.mode == TrafficLogConfig::Mode::Sync)
+        return;
+    if (config_.mode == TrafficLogConfig::Mode::Binary) {
+        file_.open(config_.file, std::ios::binary | std::ios::app);
+        if (!file_)
+            throw std::runtime_error("TrafficLog: cannot open " + config_.file);
+        if (file_.tellp() == 0)
+            file_.write(kFileMagic, sizeof(kFileMagic));
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+TrafficLog::~TrafficLog()
+{
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+    if (auto dropped = dropped_.load(std::memory_order_relaxed))
+        SPDLOG_WARN("TrafficLog dropped {} records", dropped);
+}
+
+void TrafficLog::message(TrafficFormat format, const FIX::Message& message)
+{
+    if (!enabled(format))
+        return;
+    static const std::string kEmpty;
+    const auto& header = message.getHeader();
+    const auto& msgType
+        = header.isSetField(FIX::FIELD::MsgType) ? header.getField(FIX::FIELD::MsgType) : kEmpty;
+    auto verbosity = admit(msgType);
+    if (verbosity == TrafficLogConfig::Verbosity::Off)
+        return;
+
+    thread_local std::string text;
+    if (verbosity == TrafficLogConfig::Verbosity::Full) {
+        message.toString(text);
+    } else {
+        // 摘要只取消息类型、序号和 ClOrdID，不序列化整条报文
+        text.assign("35=").append(msgType);
+        if (header.isSetField(FIX::FIELD::MsgSeqNum))
+            text.append(" 34=").append(header.getField(FIX::FIELD::MsgSeqNum));
+        if (message.isSetField(FIX::FIELD::ClOrdID))
+            text.append(" 11=").append(message.getField(FIX::FIELD::ClOrdID));
+    }
+    auto& buf = scratch();
+    buf.clear();
+    encode(buf, text);
+    write(format, buf);
+}
+
+bool TrafficLog::enabled(TrafficFormat format) const
+{
+    if (config_.mode == TrafficLogConfig::Mode::Binary)
+        return true;
+    const auto* spec = formatSpec(format);
+    return spec && spdlog::should_log(spec->level);
+}
+
+TrafficLogConfig::Verbosity TrafficLog::admit(const std::string& msgType)
+{
+    auto it = rules_.find(msgType);
+    auto& rule = it == rules_.end() ? default_rule_ : it->second;
+    if (rule.verbosity == TrafficLogConfig::Verbosity::Off)
+        return rule.verbosity;
+    if (config_.sample_every > 1 && rule.seen.fetch_add(1, std::memory_order_relaxed) % config_.sample_every != 0)
+        return TrafficLogConfig::Verbosity::Off;
+    return rule.verbosity;
+}
+
+void TrafficLog::write(TrafficFormat format, std::string_view payload)
+{
+    if (config_.mode == TrafficLogConfig::Mode::Sync) {
+        spdlog::default_logger_raw()->log(formatSpec(format)->level, TrafficLog::format(format, payload));
+        return;
+    }
+    if (!localRing().push(format, payload))
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+TrafficLog::Ring& TrafficLog::localRing()
+{
+    // 实例编号不复用，已析构实例留下的条目不会被误用
+    thread_local std::vector<std::pair<std::uint64_t, Ring*>> rings;
+    for (const auto& [id, ring] : rings) {
+        if (id == id_)
+            return *ring;
+    }
+    // 线程退出后环形缓冲仍由本实例持有，直到实例析构
+    std::lock_guard<std::mutex> lk(rings_mtx_);
+    auto* ring = rings_.emplace_back(std::make_unique<Ring>(config_.ring_kb * 1024)).get();
+    rings.emplace_back(id_, ring);
+    return *ring;
+}
+
+void TrafficLog::run()
+{
+    for (;;) {
+        if (drain() > 0)
+            continue;
+        std::unique_lock<std::mutex> lk(mtx_);
+        if (stopping_)
+            break;
+        // 写入方不发通知，空闲时按固定间隔轮询
+        cv_.wait_for(lk, std::chrono::milliseconds(1));
+    }
+    drain();
+    if (file_.is_open())
+        file_.flush();
+}
+
+std::size_t TrafficLog::drain()
+{
+    std::vector<Ring*> rings;
+    {
+        std::lock_guard<std::mutex> lk(rings_mtx_);
+        rings.reserve(rings_.size());
+        for (const auto& ring : rings_)
+            rings.push_back(ring.get());
+    }
+    std::size_t count = 0;
+    for (auto* ring : rings)
+        count += ring->consume([this](const char* record, std::size_t size) { emit(record, size); });
+    if (count > 0 && file_.is_open())
+        file_.flush();
+    return count;
+}
+
+void TrafficLog::emit(const char* record, std::size_t size)
+{
+    if (file_.is_open()) {
+        file_.write(record, static_cast<std::streamsize>(size));
+        return;
+    }
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    auto format = static_cast<TrafficFormat>(header.format);
+    const auto* spec = formatSpec(format);
+    if (!spec)
+        return;
+    auto time = spdlog::log_clock::time_point(std::chrono::duration_cast<spdlog::log_clock::duration>(
+        std::chrono::nanoseconds(header.time_ns)));
+    spdlog::default_logger_raw()->log(time, spdlog::source_loc {}, spec->level,
+        TrafficLog::format(format, std::string_view(record + sizeof(header), size - sizeof(header))));
+}
+
+std::size_t TrafficLog::decode(std::istream& in, std::ostream& out)
+{
+    char magic[sizeof(kFileMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kFileMagic, sizeof(magic)) != 0)
+        throw std::runtime_error("TrafficLog: not a traffic log file");
+    std::size_t count = 0;
+    std::string payload;
+    RecordHeader header;
+    while (in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        if (header.size < sizeof(header))
+            throw std::runtime_error("TrafficLog: corrupt record");
+        payload.resize(header.size - sizeof(header));
+        if (!in.read(payload.data(), static_cast<std::streamsize>(payload.size())))
+            break;
+        auto format = static_cast<TrafficFormat>(header.format);
+        const auto* spec = formatSpec(format);
+        if (!spec)
+            continue;
+        auto seconds = static_cast<std::time_t>(header.time_ns / 1000000000);
+        out << fmt::format("[{:%Y-%m-%d %H:%M:%S}.{:09}] [{}] {}\n", fmt::gmtime(seconds),
+            header.time_ns % 1000000000, spdlog::level::to_string_view(spec->level),
+            TrafficLog::format(format, payload));
+        ++count;
+    }
+    return count;
+}
+
+std::string& TrafficLog::scratch()
+{
+    thread_local std::string buf;
+    return buf;
+}
+
+void TrafficLog::encode(std::string& buf, std::string_view value)
+{
+    auto size = static_cast<std::uint32_t>(value.size());
+    buf.push_back('s');
+    buf.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    buf.append(value);
+}
+
+std::string TrafficLog::format(TrafficFormat format, std::string_view payload)
+{
+    std::string out;
+    const auto* spec = formatSpec(format);
+    if (!spec)
+        return out;
+    std::string_view text(spec->text);
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        auto next = text.find("{}", pos);
+        if (next == std::string_view::npos || payload.empty()) {
+            out.append(text.substr(pos));
+            break;
+        }
+        out.append(text.substr(pos, next - pos));
+        pos = next + 2;
+        auto tag = payload.front();
+        payload.remove_prefix(1);
+        if (tag == 's' && payload.size() >= sizeof(std::uint32_t)) {
+            std::uint32_t size;
+            std::memcpy(&size, payload.data(), sizeof(size));
+            payload.remove_prefix(sizeof(size));
+            size = std::min<std::uint32_t>(size, static_cast<std::uint32_t>(payload.size()));
+            out.append(payload.substr(0, size));
+            payload.remove_prefix(size);
+        } else if (tag == 'd' && payload.size() >= sizeof(double)) {
+            double v;
+            std::memcpy(&v, payload.data(), sizeof(v));
+            payload.remove_prefix(sizeof(v));
+            fmt::format_to(std::back_inserter(out), "{}", v);
+        } else if (tag == 'i' && payload.size() >= sizeof(std::int64_t)) {
+            std::int64_t v;
+            std::memcpy(&v, payload.data(), sizeof(v));
+            payload.remove_prefix(sizeof(v));
+            fmt::format_to(std::back_inserter(out), "{}", v);
+        } else {
+            payload = {};
+        }
+    }
+    return out;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "app_config.h"
+
+#include <quickfix/Message.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// 日志格式编号，记录里只存编号和参数，格式串在输出时才套用
+enum class TrafficFormat : std::uint16_t {
+    FromApp = 1,
+    ToApp,
+    FromAdmin,
+    ToAdmin,
+    NewOrder,
+    CancelOrder,
+    ReplaceOrder,
+};
+
+// 低开销的 FIX 报文 / 热路径日志。
+// sync：与原来一样在调用线程上格式化并写 spdlog，但级别被过滤时不再序列化报文；
+// deferred：调用线程只把时间戳、格式编号和原始参数字节写进本线程的环形缓冲，由后台线程格式化后写 spdlog；
+// binary：后台线程把记录原样写入文件，由 decode() 离线还原成文本。
+// 按消息类型（MsgType）设置详细程度（off / summary / full），并可每 N 条采样 1 条。
+// 线程安全；deferred / binary 模式下环形缓冲写满时丢弃新记录并计数，调用线程从不等待。
+class TrafficLog {
+public:
+    explicit TrafficLog(const TrafficLogConfig& config = {});
+    ~TrafficLog();
+
+    TrafficLog(const TrafficLog&) = delete;
+    TrafficLog& operator=(const TrafficLog&) = delete;
+
+    // 报文收发（FromApp / ToApp / FromAdmin / ToAdmin）
+    void message(TrafficFormat format, const FIX::Message& message);
+
+    // 其他格式：参数为字符串或数值
+    template <typename... Args>
+    void event(TrafficFormat format, const Args&... args)
+    {
+        if (!enabled(format))
+            return;
+        auto& buf = scratch();
+        buf.clear();
+        (encode(buf, args), ...);
+        write(format, buf);
+    }
+
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // 把 binary 模式写出的文件还原成文本，每条记录一行；返回记录数
+    static std::size_t decode(std::istream& in, std::ostream& out);
+
+private:
+    class Ring;
+
+    struct Rule {
+        TrafficLogConfig::Verbosity verbosity { TrafficLogConfig::Verbosity::Full };
+        std::atomic<std::uint32_t> seen { 0 };
+    };
+
+    bool enabled(TrafficFormat format) const;
+    // 按消息类型的详细程度与采样决定这条报文怎么记
+    TrafficLogConfig::Verbosity admit(const std::string& msgType);
+    void write(TrafficFormat format, std::string_view payload);
+    Ring& localRing();
+    void run();
+    // 返回取出的记录数
+    std::size_t drain();
+    void emit(const char* record, std::size_t size);
+
+    static std::string& scratch();
+    static void encode(std::string& buf, std::string_view value);
+    static void encode(std::string& buf, const std::string& value) { encode(buf, std::string_view(value)); }
+    static void encode(std::string& buf, const char* value) { encode(buf, std::string_view(value)); }
+
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    static void encode(std::string& buf, T value)
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            auto v = static_cast<double>(value);
+            buf.push_back('d');
+            buf.append(reinterpret_cast<const char*>(&v), sizeof(v));
+        } else {
+            auto v = static_cast<std::int64_t>(value);
+            buf.push_back('i');
+            buf.append(reinterpret_cast<const char*>(&v), sizeof(v));
+        }
+    }
+
+    // 套用格式串，输出一行文本
+    static std::string format(TrafficFormat format, std::string_view payload);
+
+private:
+    TrafficLogConfig config_;
+    const std::uint64_t id_;
+    std::unordered_map<std::string, Rule> rules_;
+    Rule default_rule_;
+    std::atomic<std::uint64_t> dropped_ { 0 };
+
+    std::mutex rings_mtx_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+    std::ofstream file_;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool stopping_ { false };
+    std::thread thread_;
+};
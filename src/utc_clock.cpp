@@ -0,0 +1,155 @@
+#include "utc_clock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define UTC_CLOCK_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define UTC_CLOCK_TSC 1
+#endif
+
+namespace {
+
+using namespace std::chrono;
+
+std::atomic<bool> g_tsc { false };
+std::atomic<int> g_precision { 3 };
+
+std::int64_t systemNs() { return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count(); }
+
+#if defined(UTC_CLOCK_TSC)
+
+constexpr std::int64_t kRecalibrateNs = 100000000;
+
+// 进程内一次性测出 TSC 频率（约 5ms）
+double nsPerTick()
+{
+    static const double ratio = [] {
+        auto ns0 = steady_clock::now();
+        auto tsc0 = __rdtsc();
+        while (steady_clock::now() - ns0 < milliseconds(5)) {
+        }
+        auto ns1 = steady_clock::now();
+        auto tsc1 = __rdtsc();
+        return static_cast<double>(duration_cast<nanoseconds>(ns1 - ns0).count()) / static_cast<double>(tsc1 - tsc0);
+    }();
+    return ratio;
+}
+
+std::int64_t tscNs()
+{
+    // 每个线程一个锚点，线程迁移到 TSC 不同步的核上时差值异常，同样触发重新锚定
+    struct Anchor {
+        std::uint64_t tsc { 0 };
+        std::int64_t ns { 0 };
+        double ns_per_tick { 0 };
+        std::uint64_t period_ticks { 0 };
+        std::int64_t last { std::numeric_limits<std::int64_t>::min() };
+    };
+    thread_local Anchor a;
+
+    auto tsc = __rdtsc();
+    std::int64_t ns;
+    if (a.ns_per_tick == 0 || tsc - a.tsc >= a.period_ticks) {
+        ns = systemNs();
+        tsc = __rdtsc();
+        auto base = nsPerTick();
+        a.ns_per_tick = base;
+        if (a.tsc != 0 && tsc > a.tsc && ns > a.ns) {
+            // 用上一周期的实测值修正频率；系统时间被调整（偏差超过 1%）时沿用初始校准
+            auto measured = static_cast<double>(ns - a.ns) / static_cast<double>(tsc - a.tsc);
+            if (measured > base * 0.99 && measured < base * 1.01)
+                a.ns_per_tick = measured;
+        }
+        a.tsc = tsc;
+        a.ns = ns;
+        a.period_ticks = static_cast<std::uint64_t>(kRecalibrateNs / a.ns_per_tick);
+    } else {
+        ns = a.ns + static_cast<std::int64_t>(static_cast<double>(tsc - a.tsc) * a.ns_per_tick);
+    }
+    // 重新锚定时外推值可能略超前于系统时间，不回退
+    a.last = std::max(a.last, ns);
+    return a.last;
+}
+
+#endif
+
+inline void write2(char* p, unsigned v)
+{
+    p[0] = static_cast<char>('0' + v / 10);
+    p[1] = static_cast<char>('0' + v % 10);
+}
+
+// 向下取整的除法，纪元之前的时间也落在正确的秒/天
+inline std::int64_t floorDiv(std::int64_t a, std::int64_t b) { return a / b - (a % b != 0 && (a < 0) != (b < 0)); }
+
+} // namespace
+
+void UtcClock::configure(const TimestampConfig& config)
+{
+#if defined(UTC_CLOCK_TSC)
+    g_tsc.store(config.clock == TimestampConfig::Clock::Tsc, std::memory_order_relaxed);
+    if (config.clock == TimestampConfig::Clock::Tsc)
+        nsPerTick();
+#endif
+    g_precision.store(std::clamp(config.precision, 0, 9), std::memory_order_relaxed);
+}
+
+std::int64_t UtcClock::nowNs()
+{
+#if defined(UTC_CLOCK_TSC)
+    if (g_tsc.load(std::memory_order_relaxed))
+        return tscNs();
+#endif
+    return systemNs();
+}
+
+std::string_view UtcClock::now() { return format(nowNs(), g_precision.load(std::memory_order_relaxed)); }
+
+std::string_view UtcClock::format(std::int64_t ns, int precision)
+{
+    // "YYYYMMDD-HH:MM:SS.fffffffff"
+    struct Cache {
+        char text[28] { '0', '0', '0', '0', '0', '0', '0', '0', '-', '0', '0', ':', '0', '0', ':', '0', '0', '.' };
+        std::int64_t second { std::numeric_limits<std::int64_t>::min() };
+        std::int64_t day { std::numeric_limits<std::int64_t>::min() };
+    };
+    thread_local Cache cache;
+
+    constexpr std::int64_t kNsPerSecond = 1000000000;
+    constexpr std::int64_t kSecondsPerDay = 86400;
+    auto second = floorDiv(ns, kNsPerSecond);
+    if (second != cache.second) {
+        auto day = floorDiv(second, kSecondsPerDay);
+        if (day != cache.day) {
+            year_month_day ymd { sys_days { days { day } } };
+            auto year = static_cast<unsigned>(static_cast<int>(ymd.year())) % 10000;
+            write2(cache.text, year / 100);
+            write2(cache.text + 2, year % 100);
+            write2(cache.text + 4, static_cast<unsigned>(ymd.month()));
+            write2(cache.text + 6, static_cast<unsigned>(ymd.day()));
+            cache.day = day;
+        }
+        auto sod = static_cast<unsigned>(second - day * kSecondsPerDay);
+        write2(cache.text + 9, sod / 3600);
+        write2(cache.text + 12, sod / 60 % 60);
+        write2(cache.text + 15, sod % 60);
+        cache.second = second;
+    }
+    precision = std::clamp(precision, 0, 9);
+    if (precision == 0)
+        return { cache.text, 17 };
+    auto fraction = static_cast<std::uint64_t>(ns - second * kNsPerSecond);
+    for (int i = precision; i < 9; ++i)
+        fraction /= 10;
+    for (int i = 18 + precision - 1; i >= 18; --i) {
+        cache.text[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    return { cache.text, static_cast<std::size_t>(18 + precision) };
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "app_config.h"
+
+#include <cstdint>
+#include <string_view>
+
+// 出站报文的 UTC 时间戳服务。
+// 每个线程缓存一份已格式化的 "YYYYMMDD-HH:MM:SS.sss" 文本：同一秒内只改写小数位，同一天内只改写时分秒，
+// 跨天才重新计算日期；不调用 gmtime / strftime，也不分配内存。
+// 时钟源默认 system_clock；tsc 模式用 rdtsc 按线程外推，每 100ms 按 system_clock 重新校准一次，保证单调不回退。
+// 线程安全；configure() 应在启动时、发送报文之前调用。
+class UtcClock {
+public:
+    static void configure(const TimestampConfig& config);
+
+    // 当前时间（Unix 纪元纳秒）
+    static std::int64_t nowNs();
+    // 当前时间，小数位数为配置的精度；视图在本线程下一次调用 now() / format() 前有效
+    static std::string_view now();
+    // 指定时间，precision 为 0~9 位小数
+    static std::string_view format(std::int64_t ns, int precision);
+};
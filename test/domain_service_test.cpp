@@ -0,0 +1,134 @@
+#include "domain_service.h"
+#include "test.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+
+DomainConfig testConfig()
+{
+    DomainConfig config;
+    config.risk.defaults.max_msgs_per_sec = 0;
+    config.risk.defaults.price_band = 0;
+    return config;
+}
+
+common::Order limitOrder(const std::string& clOrdId, char side, double price, double quantity)
+{
+    common::Order o;
+    o.clOrdId = clOrdId;
+    o.symbol = "AAPL";
+    o.account = "ACC";
+    o.side = side;
+    o.orderType = '2';
+    o.price = price;
+    o.quantity = quantity;
+    o.session = "S1";
+    return o;
+}
+
+bool throwsOnRecovery(const DomainConfig& config)
+{
+    try {
+        DomainService svc(config);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE(domainServiceFillsTakerAndMaker)
+{
+    DomainService svc(testConfig());
+    auto maker = svc.processNewOrder(limitOrder("M1", '2', 10, 5));
+    auto taker = svc.processNewOrder(limitOrder("T1", '1', 10, 3));
+    CHECK(maker.success && taker.success);
+    // 每笔成交先回报主动方，再回报被动方
+    CHECK(taker.executions.size() == 2);
+    CHECK(taker.executions.size() == 2 && taker.executions[0].order.clOrdId == "T1");
+    CHECK(taker.executions.size() == 2 && taker.executions[1].order.clOrdId == "M1");
+    auto m = svc.findOrderByOrderId(maker.orderId);
+    CHECK(m && m->status == "PARTIALLY_FILLED" && m->cumQty == 3);
+    auto t = svc.findOrderByOrderId(taker.orderId);
+    CHECK(t && t->status == "FILLED");
+}
+
+TEST_CASE(domainServiceReplaceCreatesReplacementOrder)
+{
+    DomainService svc(testConfig());
+    auto orig = svc.processNewOrder(limitOrder("B1", '1', 10, 5));
+    svc.processNewOrder(limitOrder("S1", '2', 10, 2));
+
+    common::Order request;
+    request.clOrdId = "B2";
+    request.session = "S1";
+    request.quantity = 2;
+    // 不超过已成交数量的改单被拒绝
+    CHECK(!svc.processReplaceOrder(request, "B1").success);
+
+    request.quantity = 8;
+    request.price = 11;
+    auto r = svc.processReplaceOrder(request, "B1");
+    CHECK(r.success);
+    CHECK(r.orderId != orig.orderId);
+    CHECK(r.updatedOrder.clOrdId == "B2" && r.updatedOrder.quantity == 8 && r.updatedOrder.price == 11);
+    CHECK(r.updatedOrder.cumQty == 2 && r.updatedOrder.status == "PARTIALLY_FILLED");
+    auto o = svc.findOrderByOrderId(orig.orderId);
+    CHECK(o && o->status == "REPLACED");
+    // 原订单已进入终态，不能再改；其他会话看不到该订单
+    CHECK(!svc.processReplaceOrder(request, "B1").success);
+    request.session = "S2";
+    CHECK(!svc.processReplaceOrder(request, "B2").success);
+
+    // 替换订单按新价格挂单并参与撮合
+    auto sell = svc.processNewOrder(limitOrder("S2", '2', 11, 10));
+    CHECK(sell.executions.size() == 2);
+    auto n = svc.findOrderByClOrdId("S1", "B2");
+    CHECK(n && n->status == "FILLED" && n->cumQty == 8);
+}
+
+TEST_CASE(domainServiceRecoveryRequiresSameShardLayout)
+{
+    auto dir = std::filesystem::temp_directory_path() / "black-arrow-test-journal";
+    std::filesystem::remove_all(dir);
+    auto config = testConfig();
+    config.shard_count = 2;
+    config.journal.enable = true;
+    config.journal.dir = dir.string();
+    config.journal.segment_mb = 1;
+    config.journal.snapshot_interval_s = 0;
+
+    std::string orderId;
+    {
+        DomainService svc(config);
+        auto r = svc.processNewOrder(limitOrder("B1", '1', 10, 5));
+        CHECK(r.success);
+        orderId = r.orderId;
+    }
+
+    // 分片数或路由键变化后，恢复出的订单会落在请求路由不到的分片上
+    auto more = config;
+    more.shard_count = 4;
+    CHECK(throwsOnRecovery(more));
+    auto fewer = config;
+    fewer.shard_count = 1;
+    CHECK(throwsOnRecovery(fewer));
+    auto byAccount = config;
+    byAccount.shard_key = DomainConfig::ShardKey::Account;
+    CHECK(throwsOnRecovery(byAccount));
+
+    {
+        DomainService svc(config);
+        CHECK(svc.findOrderByOrderId(orderId).has_value());
+        common::Order cancel;
+        cancel.clOrdId = "B1-C";
+        cancel.symbol = "AAPL";
+        cancel.account = "ACC";
+        cancel.session = "S1";
+        CHECK(svc.processCancelOrder(cancel, "B1").success);
+    }
+    std::filesystem::remove_all(dir);
+}
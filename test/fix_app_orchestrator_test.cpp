@@ -0,0 +1,82 @@
+#include "fix_app_orchestrator.h"
+#include "test.h"
+
+#include <quickfix/Message.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Sent {
+    std::string session;
+    std::string execType;
+};
+
+// 记录发出的执行回报，不经过 QuickFIX 会话
+class RecordingSender final : public FixSender {
+public:
+    explicit RecordingSender(std::shared_ptr<std::vector<Sent>> sent)
+        : sent_(std::move(sent))
+    {
+    }
+
+    bool sendToTarget(FIX::Message& message, const FIX::SessionID& session_id) override
+    {
+        const auto* execType = fixfield::find(message, FIX::FIELD::ExecType);
+        std::lock_guard<std::mutex> lk(mtx_);
+        sent_->push_back({ session_id.toString(), execType ? *execType : std::string() });
+        return true;
+    }
+
+private:
+    std::mutex mtx_;
+    std::shared_ptr<std::vector<Sent>> sent_;
+};
+
+FIX::Message limitOrder(const std::string& clOrdId, char side, const std::string& account)
+{
+    FIX::Message message;
+    message.getHeader().setField(FIX::FIELD::MsgType, FIX::MsgType_NewOrderSingle);
+    message.setField(FIX::FIELD::ClOrdID, clOrdId);
+    message.setField(FIX::FIELD::Symbol, "AAPL");
+    message.setField(FIX::FIELD::Side, std::string(1, side));
+    message.setField(FIX::FIELD::OrderQty, "5");
+    message.setField(FIX::FIELD::OrdType, "2");
+    message.setField(FIX::FIELD::Price, "10");
+    message.setField(FIX::FIELD::Account, account);
+    return message;
+}
+
+} // namespace
+
+TEST_CASE(orchestratorReportsFillsToLoggedOutSession)
+{
+    DomainConfig config;
+    config.risk.defaults.max_msgs_per_sec = 0;
+    config.risk.defaults.price_band = 0;
+    auto sent = std::make_shared<std::vector<Sent>>();
+    FIX::SessionID maker("FIX.4.4", "ACCEPTOR", "MAKER");
+    FIX::SessionID taker("FIX.4.4", "ACCEPTOR", "TAKER");
+    {
+        FixAppOrchestrator app(std::make_unique<DomainService>(config), std::make_unique<RecordingSender>(sent));
+        app.onCreate(maker);
+        app.onCreate(taker);
+        app.onLogon(maker);
+        app.onLogon(taker);
+        app.onFromApp(limitOrder("M1", '2', "ACC-M"), maker);
+        // 挂单方断线期间被成交，回报仍要交给 QuickFIX 存储，重连后补发
+        app.onLogout(maker);
+        app.onFromApp(limitOrder("T1", '1', "ACC-T"), taker);
+        // 析构时先处理完事件总线上已入队的回报
+    }
+    std::vector<std::string> toMaker;
+    for (const auto& s : *sent) {
+        if (s.session == maker.toString())
+            toMaker.push_back(s.execType);
+    }
+    CHECK(toMaker.size() == 2);
+    CHECK(toMaker.size() == 2 && toMaker[0] == "0" && toMaker[1] == "F");
+}
@@ -0,0 +1,125 @@
+#include "fix_message_converter.h"
+#include "fix_order_parser.h"
+#include "test.h"
+
+#include <quickfix/Message.h>
+
+#include <string>
+
+namespace {
+
+// '|' 换成 SOH，补上 BeginString、BodyLength 与 CheckSum
+std::string frame(const std::string& fields)
+{
+    std::string body = fields;
+    for (auto& c : body) {
+        if (c == '|')
+            c = '\x01';
+    }
+    auto message = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    unsigned sum = 0;
+    for (unsigned char c : message)
+        sum += c;
+    auto checksum = std::to_string(sum % 256);
+    return message + "10=" + std::string(3 - checksum.size(), '0') + checksum + "\x01";
+}
+
+struct Decoded {
+    fixfield::Error error;
+    common::Order order;
+    std::string origClOrdId;
+};
+
+// 原有路径：QuickFIX 解析成 FIX::Message，再按字段读取
+Decoded viaQuickFix(const std::string& raw)
+{
+    FIX::Message message(raw, false);
+    Decoded d;
+    const auto& type = message.getHeader().getField(FIX::FIELD::MsgType);
+    if (type == "D")
+        d.error = FixMessageConverter::parseNewOrderSingle(FIX44::NewOrderSingle(message), d.order);
+    else if (type == "F")
+        d.error = FixMessageConverter::parseCancelRequest(FIX44::OrderCancelRequest(message), d.order, d.origClOrdId);
+    else
+        d.error = FixMessageConverter::parseReplaceRequest(
+            FIX44::OrderCancelReplaceRequest(message), d.order, d.origClOrdId);
+    return d;
+}
+
+// 零拷贝路径：FixOrderParser 直接扫描原始报文
+Decoded viaParser(const std::string& raw)
+{
+    InboundOrderView view;
+    Decoded d;
+    d.error = FixOrderParser::parse(raw, view);
+    if (!d.error)
+        FixMessageConverter::toOrder(view, d.order, d.origClOrdId);
+    return d;
+}
+
+bool sameOrder(const common::Order& a, const common::Order& b)
+{
+    return a.clOrdId == b.clOrdId && a.symbol == b.symbol && a.side == b.side && a.quantity == b.quantity
+        && a.orderType == b.orderType && a.price == b.price && a.timeInForce == b.timeInForce
+        && a.account == b.account;
+}
+
+void checkSame(const std::string& fields)
+{
+    auto raw = frame(fields);
+    auto expected = viaQuickFix(raw);
+    auto actual = viaParser(raw);
+    CHECK(expected.error.status == actual.error.status);
+    CHECK(expected.error.tag == actual.error.tag);
+    if (!expected.error && !actual.error) {
+        CHECK(sameOrder(expected.order, actual.order));
+        CHECK(expected.origClOrdId == actual.origClOrdId);
+    }
+    if (expected.error.status != actual.error.status || expected.error.tag != actual.error.tag)
+        std::fprintf(stderr, "  message: %s\n", fields.c_str());
+}
+
+} // namespace
+
+TEST_CASE(fixOrderParserMatchesQuickFixOnValidOrders)
+{
+    checkSame("35=D|49=A|56=B|34=2|52=20240101-00:00:00.000|11=C1|1=ACC|55=AAPL|54=1|38=100.5|40=2|44=150.25|59=0|"
+              "60=20240101-00:00:00.000|");
+    checkSame("35=D|49=A|56=B|34=3|11=C2|55=EURUSD|54=2|38=1000000|40=1|59=3|");
+    checkSame("35=D|49=A|56=B|34=4|11=C3|55=AAPL|54=1|38=0.00000001|40=2|44=0.0001|");
+    checkSame("35=F|49=A|56=B|34=5|11=C4|41=C1|55=AAPL|54=1|60=20240101-00:00:00.000|");
+    checkSame("35=G|49=A|56=B|34=6|11=C5|41=C1|55=AAPL|54=1|38=200|44=155.5|40=2|1=ACC|");
+    checkSame("35=G|49=A|56=B|34=7|11=C6|41=C5|");
+    checkSame("35=F|49=A|56=B|34=8|11=C7|41=C1|55=AAPL|54=1|1=ACC|");
+    checkSame("35=G|49=A|56=B|34=9|11=C8|41=C5|55=AAPL|54=1|38=300|40=2|44=156|59=1|1=ACC|");
+}
+
+TEST_CASE(fixOrderParserMatchesQuickFixOnMissingFields)
+{
+    checkSame("35=D|49=A|56=B|34=2|55=AAPL|54=1|38=100|40=2|44=150|");
+    checkSame("35=D|49=A|56=B|34=2|11=C1|55=AAPL|38=100|40=2|44=150|");
+    checkSame("35=D|49=A|56=B|34=2|11=C1|54=1|38=100|40=2|44=150|");
+    checkSame("35=D|49=A|56=B|34=2|11=C1|55=AAPL|54=1|40=2|44=150|");
+    checkSame("35=D|49=A|56=B|34=2|11=C1|55=AAPL|54=1|38=100|44=150|");
+    checkSame("35=F|49=A|56=B|34=2|11=C1|55=AAPL|54=1|");
+    checkSame("35=G|49=A|56=B|34=2|41=C1|38=100|");
+}
+
+TEST_CASE(fixOrderParserMatchesQuickFixOnInvalidFields)
+{
+    checkSame("35=D|49=A|56=B|34=2|11=C1|55=AAPL|54=1|38=abc|40=2|44=150|");
+    checkSame("35=D|49=A|56=B|34=2|11=C1|55=AAPL|54=1|38=100|40=2|44=1.2.3|");
+    checkSame("35=D|49=A|56=B|34=2|11=C1|55=AAPL|54=12|38=100|40=2|44=150|");
+    checkSame("35=G|49=A|56=B|34=2|11=C1|41=C0|38=1e5|");
+}
+
+TEST_CASE(fixOrderParserMatchesQuickFixOnMixedErrors)
+{
+    // Side 格式错误且缺 Symbol：两条路径都按读取顺序报告 Side
+    checkSame("35=D|49=A|56=B|34=2|11=C1|54=12|38=100|40=2|44=150|");
+    // 缺 OrderQty 且 Price 格式错误：先报缺失的 OrderQty
+    checkSame("35=D|49=A|56=B|34=2|11=C1|55=AAPL|54=1|40=2|44=x|");
+    // 撤单不读取的字段即使格式错误也不影响受理
+    checkSame("35=F|49=A|56=B|34=2|11=C1|41=C0|38=abc|40=12|");
+    checkSame("35=F|49=A|56=B|34=2|11=C1|41=C0|54=12|");
+}
@@ -0,0 +1,117 @@
+#include "fix_field.h"
+#include "fix_simd.h"
+#include "test.h"
+
+#include <quickfix/Message.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr fixsimd::Level kLevels[] = { fixsimd::Level::Scalar, fixsimd::Level::Sse42, fixsimd::Level::Avx2 };
+
+// 在每个 CPU 支持的级别上运行 fn，结束后恢复原来的级别
+template <typename Fn>
+void forEachLevel(Fn&& fn)
+{
+    auto saved = fixsimd::level();
+    for (auto level : kLevels) {
+        if (fixsimd::setLevel(level) != level) {
+            std::printf("  %s not supported by this CPU, skipped\n", fixsimd::levelName(level));
+            continue;
+        }
+        fn(level);
+    }
+    fixsimd::setLevel(saved);
+}
+
+// 含 SOH 与 '=' 的随机文本，字节取值覆盖 0~255
+std::string randomText(std::mt19937& rng, std::size_t size)
+{
+    std::string text(size, '\0');
+    for (auto& c : text) {
+        auto r = rng() % 8;
+        c = r == 0 ? '\x01' : r == 1 ? '=' : static_cast<char>(rng() % 256);
+    }
+    return text;
+}
+
+// 补上 BeginString、BodyLength 与 CheckSum
+std::string frame(const std::string& body)
+{
+    auto message = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    unsigned sum = 0;
+    for (unsigned char c : message)
+        sum += c;
+    auto checksum = std::to_string(sum % 256);
+    return message + "10=" + std::string(3 - checksum.size(), '0') + checksum + "\x01";
+}
+
+} // namespace
+
+TEST_CASE(fixSimdFindAllMatchesReference)
+{
+    std::mt19937 rng(42);
+    // 长度覆盖 0、不足一个块、块边界两侧与多个块；起始地址按 0~31 错开
+    std::string buffer = randomText(rng, 1200);
+    forEachLevel([&](fixsimd::Level) {
+        for (std::size_t offset = 0; offset < 32; ++offset) {
+            for (std::size_t size = 0; size + offset <= 400; size += 1 + size / 16) {
+                std::string_view text(buffer.data() + offset, size);
+                std::vector<std::uint32_t> expected;
+                for (std::size_t i = 0; i < text.size(); ++i) {
+                    if (text[i] == '\x01')
+                        expected.push_back(static_cast<std::uint32_t>(i));
+                }
+                std::vector<std::uint32_t> actual(text.size() + 1);
+                auto n = fixsimd::findAll(text, '\x01', actual.data(), actual.size());
+                actual.resize(n);
+                CHECK(actual == expected);
+                // 结果被 max 截断时只写前 max 个
+                if (expected.size() > 3) {
+                    std::uint32_t first[3];
+                    CHECK(fixsimd::findAll(text, '\x01', first, 3) == 3);
+                    CHECK(first[0] == expected[0] && first[1] == expected[1] && first[2] == expected[2]);
+                }
+            }
+        }
+    });
+}
+
+TEST_CASE(fixSimdFindAllSplitsFieldsLikeQuickFix)
+{
+    // 按 findAll 找到的 SOH 切出的每个字段，都与 QuickFIX 解析同一条报文得到的字段值一致
+    const std::string bodies[] = {
+        "35=D\x01" "49=CLIENT\x01" "56=ACCEPTOR\x01" "34=12\x01" "52=20240101-00:00:00.000\x01" "11=C1\x01"
+        "1=ACC\x01" "55=AAPL\x01" "54=1\x01" "38=100.5\x01" "40=2\x01" "44=150.25\x01" "59=0\x01",
+        "35=F\x01" "49=CLIENT\x01" "56=ACCEPTOR\x01" "34=13\x01" "11=C2\x01" "41=C1\x01" "55=EURUSD\x01" "54=2\x01"
+        "58=a longer free-text field that spans more than one 32-byte block\x01",
+    };
+    forEachLevel([&](fixsimd::Level) {
+        for (const auto& body : bodies) {
+            auto raw = frame(body);
+            FIX::Message message(raw, false);
+            std::uint32_t sohs[64];
+            auto n = fixsimd::findAll(raw, '\x01', sohs, 64);
+            CHECK(n > 0 && sohs[n - 1] == raw.size() - 1);
+            std::size_t begin = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                std::string_view field(raw.data() + begin, sohs[i] - begin);
+                begin = sohs[i] + 1;
+                auto eq = field.find('=');
+                CHECK(eq != std::string_view::npos);
+                auto tag = std::stoi(std::string(field.substr(0, eq)));
+                auto value = std::string(field.substr(eq + 1));
+                const auto* expected = fixfield::find(message.getHeader(), tag);
+                if (!expected)
+                    expected = fixfield::find(message, tag);
+                if (!expected)
+                    expected = fixfield::find(message.getTrailer(), tag);
+                CHECK(expected && *expected == value);
+            }
+        }
+    });
+}
@@ -0,0 +1,110 @@
+#include "matching_engine.h"
+#include "test.h"
+
+namespace {
+
+BookOrderRequest limit(std::uint64_t id, char side, std::int64_t price, std::int64_t quantity)
+{
+    BookOrderRequest r;
+    r.id = id;
+    r.owner = static_cast<std::uint32_t>(id % 4);
+    r.side = side;
+    r.price = price;
+    r.quantity = quantity;
+    return r;
+}
+
+} // namespace
+
+TEST_CASE(orderBookRestsNonCrossingOrders)
+{
+    OrderBook book;
+    std::vector<BookFill> fills;
+    CHECK(book.match(limit(1, '1', 99, 10), true, fills) == 10);
+    CHECK(book.match(limit(2, '2', 101, 10), true, fills) == 10);
+    CHECK(fills.empty());
+    CHECK(book.bestBid() == 99);
+    CHECK(book.bestAsk() == 101);
+    CHECK(book.orderCount() == 2);
+    CHECK(book.levelCount() == 2);
+}
+
+TEST_CASE(orderBookMatchesByPriceThenTime)
+{
+    OrderBook book;
+    std::vector<BookFill> fills;
+    book.match(limit(1, '2', 101, 5), true, fills);
+    book.match(limit(2, '2', 100, 5), true, fills);
+    book.match(limit(3, '2', 100, 5), true, fills);
+    // 买 12 @ 101：先吃 100 价位（按到达顺序 2、3），再吃 101
+    auto leaves = book.match(limit(4, '1', 101, 12), true, fills);
+    CHECK(leaves == 0);
+    CHECK(fills.size() == 3);
+    CHECK(fills.size() == 3 && fills[0].maker_id == 2 && fills[0].price == 100 && fills[0].quantity == 5);
+    CHECK(fills.size() == 3 && fills[1].maker_id == 3 && fills[1].price == 100 && fills[1].quantity == 5);
+    CHECK(fills.size() == 3 && fills[2].maker_id == 1 && fills[2].price == 101 && fills[2].quantity == 2);
+    CHECK(fills.size() == 3 && fills[2].maker_leaves == 3 && fills[2].maker_owner == 1);
+    CHECK(book.bestAsk() == 101);
+    CHECK(!book.bestBid());
+    CHECK(book.orderCount() == 1);
+}
+
+TEST_CASE(orderBookRestsRemainderAtLimit)
+{
+    OrderBook book;
+    std::vector<BookFill> fills;
+    book.match(limit(1, '1', 100, 4), true, fills);
+    auto leaves = book.match(limit(2, '2', 99, 10), true, fills);
+    CHECK(leaves == 6);
+    CHECK(fills.size() == 1 && fills[0].price == 100 && fills[0].quantity == 4);
+    CHECK(book.bestAsk() == 99);
+    CHECK(!book.bestBid());
+}
+
+TEST_CASE(orderBookMarketOrdersNeverRest)
+{
+    OrderBook book;
+    std::vector<BookFill> fills;
+    book.match(limit(1, '2', 100, 3), true, fills);
+    auto market = limit(2, '1', 0, 5);
+    market.market = true;
+    CHECK(book.match(market, false, fills) == 2);
+    CHECK(fills.size() == 1 && fills[0].quantity == 3);
+    CHECK(book.orderCount() == 0);
+    CHECK(book.levelCount() == 0);
+}
+
+TEST_CASE(orderBookCancelRemovesOrderAndEmptyLevel)
+{
+    OrderBook book;
+    std::vector<BookFill> fills;
+    book.match(limit(1, '1', 100, 5), true, fills);
+    book.match(limit(2, '1', 100, 5), true, fills);
+    CHECK(book.cancel(1));
+    CHECK(!book.cancel(1));
+    CHECK(book.bestBid() == 100);
+    CHECK(book.cancel(2));
+    CHECK(!book.bestBid());
+    CHECK(book.levelCount() == 0);
+    // 已撤销的订单不再参与撮合
+    CHECK(book.match(limit(3, '2', 100, 5), true, fills) == 5);
+    CHECK(fills.empty());
+}
+
+TEST_CASE(matchingEngineKeepsSymbolsApart)
+{
+    MatchingEngine engine;
+    std::vector<BookFill> fills;
+    engine.submit("AAPL", limit(1, '2', 100, 5), true, fills);
+    CHECK(engine.submit("MSFT", limit(2, '1', 100, 5), true, fills) == 5);
+    CHECK(fills.empty());
+    CHECK(engine.submit("AAPL", limit(3, '1', 100, 5), true, fills) == 0);
+    CHECK(fills.size() == 1 && fills[0].maker_id == 1);
+    CHECK(!engine.cancel("AAPL", 1));
+    CHECK(engine.cancel("MSFT", 2));
+    // 恢复的订单不撮合，直接挂入
+    engine.restore("AAPL", limit(4, '1', 101, 1));
+    engine.restore("AAPL", limit(5, '2', 100, 1));
+    CHECK(engine.cancel("AAPL", 4));
+    CHECK(engine.cancel("AAPL", 5));
+}
@@ -0,0 +1,62 @@
+#include "order_chunk.h"
+#include "test.h"
+
+TEST_CASE(orderChunkRoundTripsRecords)
+{
+    OrderStrings strings;
+    OrderChunk chunk;
+    OrderRecordView in;
+    in.cl_ord_id = "C1";
+    in.order_id = "O1";
+    in.symbol = "EURUSD";
+    in.account = "ACC";
+    in.session = "FIX.4.4:A->B";
+    in.quantity = common::toFixed(12.5);
+    in.price = common::toFixed(1.08765);
+    in.side = '1';
+    in.order_type = '2';
+    in.time_in_force = '3';
+    in.state = common::OrderState::PartiallyFilled;
+    in.cum_qty = common::toFixed(2.5);
+    in.avg_px = common::toFixed(1.0876);
+    chunk.store(7, in, strings);
+
+    auto v = chunk.view(7, strings);
+    CHECK(v.cl_ord_id == "C1");
+    CHECK(v.order_id == "O1");
+    CHECK(v.symbol == "EURUSD");
+    CHECK(v.account == "ACC");
+    CHECK(v.session == "FIX.4.4:A->B");
+    CHECK(v.quantity == in.quantity);
+    CHECK(v.price == in.price);
+    CHECK(v.time_in_force == '3');
+    CHECK(v.state == common::OrderState::PartiallyFilled);
+    CHECK(v.cum_qty == in.cum_qty);
+
+    auto o = chunk.load(7, strings);
+    CHECK(o.clOrdId == "C1");
+    CHECK(o.quantity == 12.5);
+    CHECK(o.price == 1.08765);
+    CHECK(o.cumQty == 2.5);
+    CHECK(o.status == "PARTIALLY_FILLED");
+    CHECK(o.session == "FIX.4.4:A->B");
+}
+
+TEST_CASE(orderChunkInternsRepeatedNames)
+{
+    OrderStrings strings;
+    OrderChunk chunk;
+    OrderRecordView in;
+    in.symbol = "AAPL";
+    in.account = "ACC";
+    in.session = "S";
+    in.cl_ord_id = "C1";
+    chunk.store(0, in, strings);
+    in.cl_ord_id = "C2";
+    chunk.store(1, in, strings);
+    // 品种、账户与会话只驻留一次
+    CHECK(chunk.symbol[0] == chunk.symbol[1]);
+    CHECK(chunk.account[0] == chunk.account[1]);
+    CHECK(chunk.session[0] == chunk.session[1]);
+    CHECK(chunk.view(1, strings).cl_ord_id == "C2");
+}
@@ -0,0 +1,92 @@
+#include "order_store.h"
+#include "test.h"
+
+namespace {
+
+common::Order makeOrder(const std::string& session, const std::string& clOrdId, const std::string& orderId)
+{
+    common::Order o;
+    o.orderId = orderId;
+    o.clOrdId = clOrdId;
+    o.symbol = "AAPL";
+    o.side = '2';
+    o.quantity = 100;
+    o.orderType = '2';
+    o.price = 150.25;
+    o.timeInForce = '0';
+    o.account = "ACC";
+    o.status = "NEW";
+    o.session = session;
+    return o;
+}
+
+} // namespace
+
+TEST_CASE(orderStoreFindsByClOrdIdAndOrderId)
+{
+    OrderStore store;
+    auto h = store.insert(makeOrder("S1", "C1", "O1"));
+    CHECK(store.findByClOrdId("S1", "C1") == h);
+    CHECK(store.findByOrderId("O1") == h);
+    CHECK(store.findByOrderId("O2") == kInvalidOrderHandle);
+
+    auto o = store.get(h);
+    CHECK(o.orderId == "O1");
+    CHECK(o.clOrdId == "C1");
+    CHECK(o.symbol == "AAPL");
+    CHECK(o.side == '2');
+    CHECK(o.quantity == 100);
+    CHECK(o.price == 150.25);
+    CHECK(o.account == "ACC");
+    CHECK(o.status == "NEW");
+    CHECK(o.session == "S1");
+}
+
+TEST_CASE(orderStoreScopesClOrdIdToSession)
+{
+    OrderStore store;
+    auto a = store.insert(makeOrder("S1", "C1", "O1"));
+    auto b = store.insert(makeOrder("S2", "C1", "O2"));
+    CHECK(a != b);
+    CHECK(store.findByClOrdId("S1", "C1") == a);
+    CHECK(store.findByClOrdId("S2", "C1") == b);
+    CHECK(store.findByClOrdId("S3", "C1") == kInvalidOrderHandle);
+    // 同一会话重复的 ClOrdID 保留最早的订单
+    store.insert(makeOrder("S1", "C1", "O3"));
+    CHECK(store.findByClOrdId("S1", "C1") == a);
+}
+
+TEST_CASE(orderStoreUpdatesStateAndFill)
+{
+    OrderStore store;
+    auto h = store.insert(makeOrder("S1", "C1", "O1"));
+    store.setFill(h, common::toFixed(40), common::toFixed(150.5), common::OrderState::PartiallyFilled);
+    auto o = store.get(h);
+    CHECK(o.cumQty == 40);
+    CHECK(o.avgPx == 150.5);
+    CHECK(o.status == "PARTIALLY_FILLED");
+    store.setState(h, common::OrderState::Canceled);
+    CHECK(store.state(h) == common::OrderState::Canceled);
+    CHECK(store.size() == 1);
+}
+
+TEST_CASE(orderStoreEvictsTerminalOrdersToArchive)
+{
+    OrderStore store;
+    store.setHotCapacity(2);
+    for (int i = 0; i < 4; ++i) {
+        auto id = std::to_string(i);
+        auto h = store.insert(makeOrder("S1", "C" + id, "O" + id));
+        if (i < 2)
+            store.setState(h, common::OrderState::Filled);
+    }
+    // 最早进入终态的订单被淘汰，仍可在冷存储中按会话查到
+    CHECK(store.findByClOrdId("S1", "C0") == kInvalidOrderHandle);
+    auto archived = store.findArchivedByClOrdId("S1", "C0");
+    CHECK(archived.has_value());
+    CHECK(archived && archived->orderId == "O0" && archived->status == "FILLED");
+    CHECK(!store.findArchivedByClOrdId("S2", "C0"));
+    CHECK(store.findArchivedByOrderId("O1").has_value());
+    CHECK(store.findByClOrdId("S1", "C3") != kInvalidOrderHandle);
+    CHECK(store.metrics().evictions == 2);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+// 极简单元测试框架：TEST_CASE 定义并注册用例，CHECK 失败时输出位置并计数，不中断用例。
+// 不引入第三方测试库，由 test_main.cpp 依次运行所有用例。
+namespace test {
+
+struct Case {
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<Case>& cases()
+{
+    static std::vector<Case> all;
+    return all;
+}
+
+inline int& failures()
+{
+    static int count = 0;
+    return count;
+}
+
+struct Registrar {
+    Registrar(const char* name, void (*run)()) { cases().push_back({ name, run }); }
+};
+
+} // namespace test
+
+#define TEST_CASE(name)                                              \
+    static void name();                                              \
+    static const test::Registrar name##_registrar { #name, &name }; \
+    static void name()
+
+#define CHECK(cond)                                                                       \
+    do {                                                                                  \
+        if (!(cond)) {                                                                    \
+            ++test::failures();                                                           \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        }                                                                                 \
+    } while (0)
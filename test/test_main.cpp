@@ -0,0 +1,20 @@
+#include "test.h"
+
+#include <cstring>
+
+// 用法：black-arrow-tests [用例名子串]，有失败时返回非零
+int main(int argc, char* argv[])
+{
+    const char* filter = argc > 1 ? argv[1] : "";
+    int run = 0;
+    for (const auto& c : test::cases()) {
+        if (!std::strstr(c.name, filter))
+            continue;
+        auto before = test::failures();
+        c.run();
+        ++run;
+        std::printf("%s %s\n", test::failures() == before ? "[ OK ]" : "[FAIL]", c.name);
+    }
+    std::printf("%d case(s), %d failed check(s)\n", run, test::failures());
+    return test::failures() == 0 ? 0 : 1;
+}
@@ -95,6 +95,23 @@ after_build(function(target)
 	task.run("uber_pkg", { archive = false })
 end)
 
+--- unit tests: xmake build black-arrow-tests && xmake run black-arrow-tests [case-name-substring]
+target("black-arrow-tests")
+	add_files("test/*.cpp", "src/*.cpp")
+	remove_files("src/acceptor_main.cpp", "src/initiator_main.cpp")
+	add_includedirs("src", "test")
+	set_kind("binary")
+	set_default(false)
+	add_tests("default")
+
+--- benchmarks: xmake build -m release black-arrow-bench && xmake run black-arrow-bench [case-name-substring]
+target("black-arrow-bench")
+	add_files("bench/*.cpp", "src/*.cpp")
+	remove_files("src/acceptor_main.cpp", "src/initiator_main.cpp")
+	add_includedirs("src", "bench")
+	set_kind("binary")
+	set_default(false)
+
 task("uber_pkg")
 on_run(function()
 	import("core.project.project")